@@ -0,0 +1,328 @@
+#pragma once
+
+#include "tagged_union.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// C-compatible description of a UNION type, for passing unions across a shared-library boundary without templates.
+// Fields are only ever appended; plugins check version before reading fields added in later versions.
+#define TU_UNION_DESCRIPTOR_VERSION 2
+
+extern "C" {
+struct tu_alternative_info {
+    size_t size;
+    size_t align;
+    // Null-terminated field name
+    char const *name;
+};
+
+// Identity of an alternative's type, added in version 2. Null-terminated.
+struct tu_alternative_type {
+    // As spelled in the UNION definition after macro expansion, e.g. "std::string"
+    char const *spelling;
+    // As named by the compiler, e.g. "std::__cxx11::basic_string<char>"
+    char const *name;
+};
+
+struct tu_union_descriptor {
+    uint32_t version;
+    uint32_t tag_count;
+    size_t size;
+    size_t align;
+    char const *name;
+    tu_alternative_info const *alternatives;
+    uint32_t (*get_tag)(void const *object);
+    // Address of the active alternative as visit passes it: behind the box for BOXED alternatives, and the tu::rec
+    // itself (not the node it points to) for tu::rec alternatives, as alternative_types names it
+    void *(*get_alternative)(void *object);
+    // Construct a union at the uninitialized dest and return 0, or return nonzero if the constructor threw; null if
+    // the union is not copyable
+    int (*copy_construct)(void *dest, void const *source);
+    int (*move_construct)(void *dest, void *source);
+    void (*destroy)(void *object);
+    // Null if the union is not hashable
+    size_t (*hash)(void const *object);
+    // Version 2: the union's name with its namespaces, as named by the compiler, and the type of each alternative
+    char const *qualified_name;
+    tu_alternative_type const *alternative_types;
+};
+
+// Non-owning reference to a union and its descriptor
+struct tu_any_union {
+    tu_union_descriptor const *descriptor;
+    void *object;
+};
+}
+
+namespace tu {
+namespace detail {
+template<typename T>
+constexpr char const *signature() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+}
+
+// The name of T as the compiler spells it in signature<T>(), e.g. "ns::Msg"
+template<typename T>
+constexpr std::string_view type_name_view() noexcept {
+    std::string_view text = signature<T>();
+#if defined(_MSC_VER) && !defined(__clang__)
+    // "const char *__cdecl tu::detail::signature<ns::Msg>(void)"
+    std::size_t first = text.find("signature<") + 10;
+    std::size_t last = text.rfind(">(void)");
+#else
+    // "constexpr const char* tu::detail::signature() [with T = ns::Msg]" on GCC, "... [T = ns::Msg]" on Clang
+    std::size_t first = text.find("T = ") + 4;
+    std::size_t last = text.rfind(']');
+#endif
+    return text.substr(first, last - first);
+}
+
+// Null-terminated copy of type_name_view<T>(), for the descriptor
+template<typename T>
+struct type_name {
+    static constexpr std::string_view view = type_name_view<T>();
+
+    static constexpr auto value = [] {
+        std::array<char, view.size() + 1> name{};
+        std::copy(view.begin(), view.end(), name.begin());
+        return name;
+    }();
+};
+
+template<typename Union, std::size_t i>
+struct field_type_spelling {
+    static constexpr auto value = [] {
+        std::array<char, Union::field_types[i].size() + 1> spelling{};
+        std::copy(Union::field_types[i].begin(), Union::field_types[i].end(), spelling.begin());
+        return spelling;
+    }();
+};
+
+template<typename Union>
+struct descriptor_functions {
+    static uint32_t get_tag(void const *object) {
+        return static_cast<uint32_t>(static_cast<Union const *>(object)->get_tag());
+    }
+
+    static void *get_alternative(void *object) {
+        return static_cast<Union *>(object)->template visit_table<void *>([](auto, auto &alternative) {
+            return static_cast<void *>(std::addressof(alternative));
+        });
+    }
+
+    static int copy_construct(void *dest, void const *source) {
+        try {
+            std::construct_at(static_cast<Union *>(dest), *static_cast<Union const *>(source));
+            return 0;
+        } catch (...) {
+            return 1;
+        }
+    }
+
+    static int move_construct(void *dest, void *source) {
+        try {
+            std::construct_at(static_cast<Union *>(dest), std::move(*static_cast<Union *>(source)));
+            return 0;
+        } catch (...) {
+            return 1;
+        }
+    }
+
+    static void destroy(void *object) {
+        std::destroy_at(static_cast<Union *>(object));
+    }
+
+    static size_t hash(void const *object) {
+        return std::hash<Union>{}(*static_cast<Union const *>(object));
+    }
+
+    // Taking the address instantiates the function, so it is only done if the union supports the operation
+    static constexpr auto copy_construct_or_null() noexcept -> int (*)(void *, void const *) {
+        if constexpr (std::is_copy_constructible_v<Union>) {
+            return &copy_construct;
+        } else {
+            return nullptr;
+        }
+    }
+
+    static constexpr auto hash_or_null() noexcept -> size_t (*)(void const *) {
+        if constexpr (requires(Union const &value) { std::hash<Union>{}(value); }) {
+            return &hash;
+        } else {
+            return nullptr;
+        }
+    }
+};
+
+template<typename Union, typename = std::make_index_sequence<Union::alternative_count>>
+struct alternative_infos;
+
+template<typename Union, std::size_t... index>
+struct alternative_infos<Union, std::index_sequence<index...>> {
+    template<std::size_t i>
+    using alternative_t = typename Union::template alternative_t<static_cast<typename Union::tag_t>(i)>;
+
+    static constexpr tu_alternative_info value[] = {{sizeof(alternative_t<index>), alignof(alternative_t<index>), Union::tag_names[index].data()}...};
+
+    static constexpr tu_alternative_type types[] = {{field_type_spelling<Union, index>::value.data(), type_name<alternative_t<index>>::value.data()}...};
+};
+}
+
+// Descriptor of Union with functions instantiated in the calling library. Two libraries may hold distinct descriptors
+// for the same union, so compare them with tu::compatible rather than by address.
+template<typename Union>
+inline constexpr tu_union_descriptor descriptor_v = {
+    TU_UNION_DESCRIPTOR_VERSION,
+    static_cast<uint32_t>(Union::alternative_count),
+    sizeof(Union),
+    alignof(Union),
+    Union::union_name.data(),
+    detail::alternative_infos<Union>::value,
+    &detail::descriptor_functions<Union>::get_tag,
+    &detail::descriptor_functions<Union>::get_alternative,
+    detail::descriptor_functions<Union>::copy_construct_or_null(),
+    &detail::descriptor_functions<Union>::move_construct,
+    &detail::descriptor_functions<Union>::destroy,
+    detail::descriptor_functions<Union>::hash_or_null(),
+    detail::type_name<Union>::value.data(),
+    detail::alternative_infos<Union>::types,
+};
+
+// Whether two descriptors describe the same union: same name, size and alternatives, in the same order, and from
+// version 2 the same qualified name and alternative types. Descriptors of different versions are compared on the
+// fields that both have.
+inline bool compatible(tu_union_descriptor const &a, tu_union_descriptor const &b) noexcept {
+    if (&a == &b) {
+        return true;
+    }
+    uint32_t version = std::min(a.version, b.version);
+    if (version < 1 || a.tag_count != b.tag_count || a.size != b.size || a.align != b.align || std::string_view(a.name) != b.name) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.tag_count; ++i) {
+        tu_alternative_info const &x = a.alternatives[i], &y = b.alternatives[i];
+        if (x.size != y.size || x.align != y.align || std::string_view(x.name) != y.name) {
+            return false;
+        }
+    }
+    if (version >= 2) {
+        if (std::string_view(a.qualified_name) != b.qualified_name) {
+            return false;
+        }
+        for (uint32_t i = 0; i < a.tag_count; ++i) {
+            tu_alternative_type const &x = a.alternative_types[i], &y = b.alternative_types[i];
+            if (std::string_view(x.spelling) != y.spelling || std::string_view(x.name) != y.name) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// C++ view of a tu_any_union. A library that knows the union type gets it back with get_if and visits it natively;
+// one that doesn't dispatches on the tag with tu::any_dispatch, or copies, destroys and hashes it through the descriptor.
+struct any_union {
+public:
+    any_union(tu_any_union handle) noexcept : m_handle(handle) {}
+
+    template<typename Union>
+        requires requires { Union::union_name; }
+    any_union(Union &value) noexcept : m_handle{&descriptor_v<Union>, std::addressof(value)} {}
+
+    tu_any_union handle() const noexcept {
+        return m_handle;
+    }
+
+    tu_union_descriptor const &descriptor() const noexcept {
+        return *m_handle.descriptor;
+    }
+
+    std::string_view name() const noexcept {
+        return m_handle.descriptor->name;
+    }
+
+    std::size_t tag() const noexcept {
+        return m_handle.descriptor->get_tag(m_handle.object);
+    }
+
+    std::string_view tag_name() const noexcept {
+        return m_handle.descriptor->alternatives[tag()].name;
+    }
+
+    void *alternative() const noexcept {
+        return m_handle.descriptor->get_alternative(m_handle.object);
+    }
+
+    // The union, or nullptr if it is not a Union as laid out in this library
+    template<typename Union>
+    Union *get_if() const noexcept {
+        return compatible(*m_handle.descriptor, descriptor_v<Union>) ? static_cast<Union *>(m_handle.object) : nullptr;
+    }
+
+    // The hash of the union, or std::nullopt if it is not hashable
+    std::optional<std::size_t> hash() const {
+        if (!m_handle.descriptor->hash) {
+            return std::nullopt;
+        }
+        return m_handle.descriptor->hash(m_handle.object);
+    }
+
+private:
+    tu_any_union m_handle;
+};
+
+// Dispatch on the tag of unions known only by descriptor, to handlers registered by field name. The table from tags to
+// handlers is built on the first call with each descriptor and cached, so steady-state dispatch is one indirect call.
+// Not thread-safe; use one per thread.
+template<typename ReturnType, typename... Args>
+struct any_dispatch {
+public:
+    using handler_t = ReturnType (*)(void *alternative, Args... args);
+
+    // fallback handles alternatives without a handler
+    explicit any_dispatch(handler_t fallback) noexcept : m_fallback(fallback) {}
+
+    any_dispatch &on(std::string_view tag_name, handler_t handler) {
+        m_handlers.emplace_back(tag_name, handler);
+        m_cached = nullptr;
+        return *this;
+    }
+
+    ReturnType operator()(any_union value, Args... args) {
+        tu_union_descriptor const *descriptor = &value.descriptor();
+        if (descriptor != m_cached) {
+            bind(*descriptor);
+        }
+        return m_table[value.tag()](value.alternative(), std::forward<Args>(args)...);
+    }
+
+private:
+    void bind(tu_union_descriptor const &descriptor) {
+        m_table.assign(descriptor.tag_count, m_fallback);
+        for (uint32_t i = 0; i < descriptor.tag_count; ++i) {
+            for (auto const &[name, handler] : m_handlers) {
+                if (name == descriptor.alternatives[i].name) {
+                    m_table[i] = handler;
+                }
+            }
+        }
+        m_cached = &descriptor;
+    }
+
+    handler_t m_fallback;
+    std::vector<std::pair<std::string_view, handler_t>> m_handlers;
+    std::vector<handler_t> m_table;
+    tu_union_descriptor const *m_cached = nullptr;
+};
+}
@@ -0,0 +1,347 @@
+#pragma once
+
+#include "tagged_union.hpp"
+
+#include <atomic>
+#include <bit>
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_clear_padding)
+#define TU_HAS_CLEAR_PADDING
+#endif
+#endif
+
+namespace tu {
+namespace detail {
+// Whether every bit of T takes part in its value, so that the padding of an alternative cannot make equal unions
+// compare unequal when the compiler cannot clear it
+template<typename T>
+inline constexpr bool has_no_padding_v = std::has_unique_object_representations_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Object representation of value in which the bytes that are not part of the tag or the active alternative
+// (padding, and the inactive bytes of the storage) are zero, so that equal unions have equal representations
+template<typename Union>
+std::array<std::byte, sizeof(Union)> representation(Union const &value) noexcept {
+    std::array<std::byte, sizeof(Union)> raw{};
+    auto const *bytes = reinterpret_cast<std::byte const *>(std::addressof(value));
+    constexpr tu::layout_info layout = Union::layout_info();
+    if constexpr (layout.tag_size == 0) {
+        // The tag is encoded in the niches of the storage
+        std::memcpy(raw.data(), bytes, sizeof(Union));
+    } else {
+        std::memcpy(raw.data() + layout.tag_offset, bytes + layout.tag_offset, layout.tag_size);
+        value.template visit_table<void>([&](auto, auto const &alternative) {
+            using alternative_t = std::remove_cvref_t<decltype(alternative)>;
+            if constexpr (!std::is_empty_v<alternative_t>) {
+                std::size_t offset = static_cast<std::size_t>(reinterpret_cast<std::byte const *>(std::addressof(alternative)) - bytes);
+                alignas(alternative_t) std::byte copy[sizeof(alternative_t)];
+                std::memcpy(copy, std::addressof(alternative), sizeof(alternative_t));
+#if defined(TU_HAS_CLEAR_PADDING)
+                __builtin_clear_padding(std::launder(reinterpret_cast<alternative_t *>(copy)));
+#else
+                static_assert(has_no_padding_v<alternative_t>, "tu::atomic: alternatives with padding need __builtin_clear_padding");
+#endif
+                std::memcpy(raw.data() + offset, copy, sizeof(alternative_t));
+            }
+        });
+    }
+    return raw;
+}
+
+template<std::size_t size>
+using atomic_word_t = std::conditional_t<size <= 1, std::uint8_t,
+    std::conditional_t<size <= 2, std::uint16_t,
+        std::conditional_t<size <= 4, std::uint32_t, std::uint64_t>>>;
+
+template<typename Union, typename Word>
+Word to_word(Union const &value) noexcept {
+    Word word = 0;
+    auto raw = representation(value);
+    std::memcpy(&word, raw.data(), sizeof(Union));
+    return word;
+}
+
+template<typename Union, typename Word>
+Union from_word(Word word) noexcept {
+    std::array<std::byte, sizeof(Union)> raw;
+    std::memcpy(raw.data(), &word, sizeof(Union));
+    return std::bit_cast<Union>(raw);
+}
+
+// Unions of up to 8 bytes, padded to a power of two and updated with a single-width CAS
+template<typename Union>
+struct word_atomic {
+public:
+    using word_t = atomic_word_t<sizeof(Union)>;
+
+    static constexpr bool is_always_lock_free = std::atomic<word_t>::is_always_lock_free;
+
+    explicit word_atomic(Union const &value) noexcept
+        : m_word(to_word<Union, word_t>(value)) {}
+
+    Union load(std::memory_order order) const noexcept {
+        return from_word<Union>(m_word.load(order));
+    }
+
+    void store(Union const &value, std::memory_order order) noexcept {
+        m_word.store(to_word<Union, word_t>(value), order);
+    }
+
+    Union exchange(Union const &value, std::memory_order order) noexcept {
+        return from_word<Union>(m_word.exchange(to_word<Union, word_t>(value), order));
+    }
+
+    bool compare_exchange_weak(Union &expected, Union const &desired, std::memory_order success, std::memory_order failure) noexcept {
+        word_t word = to_word<Union, word_t>(expected);
+        if (m_word.compare_exchange_weak(word, to_word<Union, word_t>(desired), success, failure)) {
+            return true;
+        }
+        expected = from_word<Union>(word);
+        return false;
+    }
+
+    bool compare_exchange_strong(Union &expected, Union const &desired, std::memory_order success, std::memory_order failure) noexcept {
+        word_t word = to_word<Union, word_t>(expected);
+        if (m_word.compare_exchange_strong(word, to_word<Union, word_t>(desired), success, failure)) {
+            return true;
+        }
+        expected = from_word<Union>(word);
+        return false;
+    }
+
+private:
+    std::atomic<word_t> m_word;
+};
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+// Unions of up to 16 bytes, updated with a double-width CAS (cmpxchg16b, casp). The __sync builtins are used because
+// they are inlined, while 16-byte std::atomic goes through libatomic. They are always sequentially consistent.
+template<typename Union>
+struct dword_atomic {
+public:
+    __extension__ typedef unsigned __int128 word_t;
+
+    static constexpr bool is_always_lock_free = true;
+
+    explicit dword_atomic(Union const &value) noexcept
+        : m_word(to_word<Union, word_t>(value)) {}
+
+    Union load(std::memory_order) const noexcept {
+        return from_word<Union>(__sync_val_compare_and_swap(&m_word, word_t(0), word_t(0)));
+    }
+
+    void store(Union const &value, std::memory_order order) noexcept {
+        exchange(value, order);
+    }
+
+    Union exchange(Union const &value, std::memory_order) noexcept {
+        word_t desired = to_word<Union, word_t>(value);
+        // A guess, which the first CAS replaces with the current value unless it was right
+        word_t current = 0;
+        for (word_t previous; (previous = __sync_val_compare_and_swap(&m_word, current, desired)) != current;) {
+            current = previous;
+        }
+        return from_word<Union>(current);
+    }
+
+    bool compare_exchange_weak(Union &expected, Union const &desired, std::memory_order success, std::memory_order failure) noexcept {
+        return compare_exchange_strong(expected, desired, success, failure);
+    }
+
+    bool compare_exchange_strong(Union &expected, Union const &desired, std::memory_order, std::memory_order) noexcept {
+        word_t word = to_word<Union, word_t>(expected);
+        word_t previous = __sync_val_compare_and_swap(&m_word, word, to_word<Union, word_t>(desired));
+        if (previous == word) {
+            return true;
+        }
+        expected = from_word<Union>(previous);
+        return false;
+    }
+
+private:
+    alignas(16) mutable word_t m_word;
+};
+#endif
+
+// Larger unions, protected by a sequence lock: writers serialize on the sequence number, readers copy the words and
+// retry if a writer was active, without writing to shared memory
+template<typename Union>
+struct seqlock_atomic {
+public:
+    static constexpr bool is_always_lock_free = false;
+
+    explicit seqlock_atomic(Union const &value) noexcept {
+        write(representation(value));
+    }
+
+    Union load(std::memory_order) const noexcept {
+        for (;;) {
+            std::uint64_t sequence = m_sequence.load(std::memory_order_acquire);
+            if (sequence & 1) {
+                cpu_relax();
+                continue;
+            }
+            raw_t raw = read();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == sequence) {
+                return from_raw(raw);
+            }
+        }
+    }
+
+    void store(Union const &value, std::memory_order order) noexcept {
+        exchange(value, order);
+    }
+
+    Union exchange(Union const &value, std::memory_order) noexcept {
+        std::uint64_t sequence = lock();
+        raw_t previous = read();
+        write(representation(value));
+        unlock(sequence);
+        return from_raw(previous);
+    }
+
+    bool compare_exchange_weak(Union &expected, Union const &desired, std::memory_order success, std::memory_order failure) noexcept {
+        return compare_exchange_strong(expected, desired, success, failure);
+    }
+
+    bool compare_exchange_strong(Union &expected, Union const &desired, std::memory_order, std::memory_order) noexcept {
+        std::uint64_t sequence = lock();
+        raw_t previous = read();
+        bool equal = previous == representation(expected);
+        if (equal) {
+            write(representation(desired));
+        }
+        unlock(sequence);
+        if (!equal) {
+            expected = from_raw(previous);
+        }
+        return equal;
+    }
+
+private:
+    using raw_t = std::array<std::byte, sizeof(Union)>;
+
+    static constexpr std::size_t words = (sizeof(Union) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    static Union from_raw(raw_t const &raw) noexcept {
+        return std::bit_cast<Union>(raw);
+    }
+
+    // Returns the odd sequence number held while locked
+    std::uint64_t lock() noexcept {
+        std::uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+        while ((sequence & 1) || !m_sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            cpu_relax();
+            sequence = m_sequence.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        return sequence + 1;
+    }
+
+    void unlock(std::uint64_t sequence) noexcept {
+        m_sequence.store(sequence + 1, std::memory_order_release);
+    }
+
+    raw_t read() const noexcept {
+        std::uint64_t data[words];
+        for (std::size_t i = 0; i < words; ++i) {
+            data[i] = m_words[i].load(std::memory_order_relaxed);
+        }
+        raw_t raw;
+        std::memcpy(raw.data(), data, sizeof(Union));
+        return raw;
+    }
+
+    void write(raw_t const &raw) noexcept {
+        std::uint64_t data[words] = {};
+        std::memcpy(data, raw.data(), sizeof(Union));
+        for (std::size_t i = 0; i < words; ++i) {
+            m_words[i].store(data[i], std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<std::uint64_t> m_sequence{0};
+    std::atomic<std::uint64_t> m_words[words];
+};
+
+template<typename Union>
+using atomic_backend_t = std::conditional_t<sizeof(Union) <= 8 && word_atomic<Union>::is_always_lock_free, word_atomic<Union>,
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+    std::conditional_t<sizeof(Union) <= 16, dword_atomic<Union>, seqlock_atomic<Union>>
+#else
+    seqlock_atomic<Union>
+#endif
+    >;
+}
+
+// Atomic cell holding a trivially copyable union. Unions of up to 8 bytes use a single-width CAS, unions of up to
+// 16 bytes a double-width CAS where the target has one inline (e.g. x86-64 with -mcx16, AArch64), and larger unions
+// a sequence lock. Unions are compared by their tag and the bytes of the active alternative, so compare_exchange
+// does not fail because of padding or of bytes left over from a previous alternative.
+template<typename Union>
+struct atomic {
+public:
+    static_assert(std::is_trivially_copyable_v<Union>, "tu::atomic requires a trivially copyable union");
+
+    using union_type = Union;
+    using tag_t = typename Union::tag_t;
+
+    static constexpr bool is_always_lock_free = detail::atomic_backend_t<Union>::is_always_lock_free;
+
+    explicit atomic(Union const &value) noexcept
+        : m_backend(value) {}
+
+    atomic(atomic const &) = delete;
+    atomic &operator=(atomic const &) = delete;
+
+    bool is_lock_free() const noexcept {
+        return is_always_lock_free;
+    }
+
+    Union load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return m_backend.load(order);
+    }
+
+    void store(Union const &value, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        m_backend.store(value, order);
+    }
+
+    Union exchange(Union const &value, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return m_backend.exchange(value, order);
+    }
+
+    bool compare_exchange_weak(Union &expected, Union const &desired, std::memory_order success, std::memory_order failure) noexcept {
+        return m_backend.compare_exchange_weak(expected, desired, success, failure);
+    }
+
+    bool compare_exchange_weak(Union &expected, Union const &desired, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return m_backend.compare_exchange_weak(expected, desired, order, failure_order(order));
+    }
+
+    bool compare_exchange_strong(Union &expected, Union const &desired, std::memory_order success, std::memory_order failure) noexcept {
+        return m_backend.compare_exchange_strong(expected, desired, success, failure);
+    }
+
+    bool compare_exchange_strong(Union &expected, Union const &desired, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return m_backend.compare_exchange_strong(expected, desired, order, failure_order(order));
+    }
+
+private:
+    static constexpr std::memory_order failure_order(std::memory_order order) noexcept {
+        return order == std::memory_order_acq_rel ? std::memory_order_acquire
+            : order == std::memory_order_release  ? std::memory_order_relaxed
+                                                  : order;
+    }
+
+    detail::atomic_backend_t<Union> m_backend;
+};
+}
@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+"""Compile-time benchmark for UNION types with many alternatives.
+
+Generates a translation unit per alternative count, each defining one UNION and
+using its accessors, visit and match, and times preprocessing and a full
+-fsyntax-only compilation with every available compiler.
+
+    python3 bench/compile_time.py [--counts 8 32 128] [--cxx g++ clang++] [--repeat 3]
+
+With --types, generates one translation unit defining that many UNION types,
+each used through every value category of visit, visit_table, visit_expect,
+match, get_ref and get_*_ref, and compares an -O2 object compilation of the
+ref-qualified overload sets (-DTU_NO_DEDUCING_THIS) against the deducing-this
+path. The std defaults to c++23 for this mode; compilers without explicit
+object parameters build the overload sets in both columns.
+
+    python3 bench/compile_time.py --types 100 [--std c++23]
+"""
+
+import argparse
+import pathlib
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+ROOT = pathlib.Path(__file__).resolve().parent.parent
+
+
+def generate(count):
+    lines = ['#include "tagged_union.hpp"', '', '#include <string>', '', 'UNION(Message']
+    for i in range(count):
+        field_type = 'std::string' if i % 4 == 0 else 'struct { int x; int y; }' if i % 4 == 1 else 'int'
+        lines.append(f'    , ({field_type}, f{i})')
+    lines += [
+        ');',
+        '',
+        'struct Matcher {',
+        '    int case_f0(std::string const &s) { return static_cast<int>(s.size()); }',
+        '    int otherwise(Message const &) { return 0; }',
+        '};',
+        '',
+        'int run(Message const &m) {',
+        '    int n = m.visit<int>([](auto, auto const &) { return 1; });',
+        '    n += m.match<int>(Matcher{});',
+        f'    n += m.holds_f{count - 1}() ? 1 : 0;',
+        '    return n;',
+        '}',
+        '',
+        'int main() {',
+        '    Message m = Message::create_f0("hello");',
+        '    Message c = m;',
+        f'    c.emplace_f{count - 1}();',
+        '    return run(m) + run(c);',
+        '}',
+        '',
+    ]
+    return '\n'.join(lines)
+
+
+def generate_types(types):
+    lines = ['#include "tagged_union.hpp"', '', '#include <string>', '#include <utility>', '']
+    for t in range(types):
+        lines += [
+            f'UNION(Message{t}',
+            '    , (std::string, text)',
+            '    , (int, number)',
+            '    , (double, real)',
+            '    , (struct { int x; int y; }, point)',
+            ');',
+            '',
+            f'struct Matcher{t} {{',
+            '    template<typename T>',
+            '    int case_text(T &&s) { return static_cast<int>(s.size()); }',
+            '    template<typename T>',
+            f'    int otherwise(T &&) {{ return {t}; }}',
+            '};',
+            '',
+            f'int use{t}(Message{t} &m, Message{t} const &c) {{',
+            '    auto v = [](auto, auto &&) { return 1; };',
+            '    int n = m.visit<int>(v) + c.visit<int>(v) + Message' + str(t) + '(c).visit<int>(v);',
+            '    n += m.visit_table<int>(v) + c.visit_table<int>(v) + std::move(m).visit_table<int>(v);',
+            f'    n += m.visit_expect<Message{t}::tag_t::number, int>(v) + c.visit_expect<Message{t}::tag_t::number, int>(v);',
+            f'    n += m.match<int>(Matcher{t}{{}}) + c.match<int>(Matcher{t}{{}}) + Message{t}(c).match<int>(Matcher{t}{{}});',
+            '    if (c.holds_number()) {',
+            f'        n += m.get_ref<Message{t}::tag_t::number>() + c.get_number_ref() + std::move(m).get_number_ref();',
+            '    }',
+            '    return n;',
+            '}',
+            '',
+        ]
+    lines += [
+        'int main(int argc, char **) {',
+        '    int n = 0;',
+    ]
+    for t in range(types):
+        lines += [
+            '    {',
+            f'        Message{t} m = Message{t}::create_number(argc);',
+            f'        n += use{t}(m, Message{t}::create_text("hello"));',
+            '    }',
+        ]
+    lines += ['    return n;', '}', '']
+    return '\n'.join(lines)
+
+
+def text_size(path):
+    size = shutil.which('size')
+    if size:
+        result = subprocess.run([size, '-A', str(path)], stdout=subprocess.PIPE, text=True, check=True)
+        return sum(int(line.split()[1]) for line in result.stdout.splitlines() if line.startswith('.text'))
+    return path.stat().st_size
+
+
+def measure(command, repeat):
+    best = float('inf')
+    for _ in range(repeat):
+        start = time.perf_counter()
+        result = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+        elapsed = time.perf_counter() - start
+        if result.returncode != 0:
+            raise RuntimeError(f'{" ".join(command)} failed:\n{result.stderr}')
+        best = min(best, elapsed)
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--counts', type=int, nargs='+', default=[8, 32, 128])
+    parser.add_argument('--cxx', nargs='+', default=['g++', 'clang++'])
+    parser.add_argument('--std', default=None)
+    parser.add_argument('--repeat', type=int, default=3)
+    parser.add_argument('--types', type=int, default=None)
+    args = parser.parse_args()
+
+    compilers = [cxx for cxx in args.cxx if shutil.which(cxx)]
+    if not compilers:
+        sys.exit(f'none of the compilers {args.cxx} were found')
+
+    if args.types is not None:
+        compare_method_sets(args.types, compilers, args.std or 'c++23', args.repeat)
+        return
+    args.std = args.std or 'c++20'
+
+    print(f'{"compiler":<12} {"alternatives":>12} {"preprocess [s]":>15} {"compile [s]":>12}')
+    with tempfile.TemporaryDirectory() as tmp:
+        for count in args.counts:
+            source = pathlib.Path(tmp) / f'union_{count}.cpp'
+            source.write_text(generate(count))
+            for cxx in compilers:
+                base = [cxx, f'-std={args.std}', f'-I{ROOT}', str(source)]
+                try:
+                    preprocess = measure(base + ['-E', '-o', '-'], args.repeat)
+                    compile_ = measure(base + ['-fsyntax-only'], args.repeat)
+                except RuntimeError as error:
+                    print(f'{cxx:<12} {count:>12} {"failed":>15} {"":>12}')
+                    print(error, file=sys.stderr)
+                    continue
+                print(f'{cxx:<12} {count:>12} {preprocess:>15.3f} {compile_:>12.3f}')
+
+
+def compare_method_sets(types, compilers, std, repeat):
+    print(f'{"compiler":<12} {"method sets":<14} {"compile [s]":>12} {".text [bytes]":>14}')
+    with tempfile.TemporaryDirectory() as tmp:
+        source = pathlib.Path(tmp) / f'types_{types}.cpp'
+        source.write_text(generate_types(types))
+        for cxx in compilers:
+            for label, defines in (('overloads', ['-DTU_NO_DEDUCING_THIS']), ('deducing this', [])):
+                output = pathlib.Path(tmp) / 'types.o'
+                command = [cxx, f'-std={std}', '-O2', f'-I{ROOT}', *defines, '-c', str(source), '-o', str(output)]
+                try:
+                    elapsed = measure(command, repeat)
+                except RuntimeError as error:
+                    print(f'{cxx:<12} {label:<14} {"failed":>12} {"":>14}')
+                    print(error, file=sys.stderr)
+                    continue
+                print(f'{cxx:<12} {label:<14} {elapsed:>12.3f} {text_size(output):>14}')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,487 @@
+#include "../tagged_union.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+// Every operation is measured on a UNION, a std::variant and a hand-written enum + union with the same
+// alternatives: 2, 8 or 32 distinct payload types, either trivial or holding a heap-allocated string
+
+template<int I>
+struct trivial {
+    std::int64_t value;
+};
+
+template<int I>
+struct nontrivial {
+    std::string value;
+};
+
+template<int I>
+trivial<I> make_payload(std::type_identity<trivial<I>>, std::int64_t k) {
+    return {k};
+}
+
+template<int I>
+nontrivial<I> make_payload(std::type_identity<nontrivial<I>>, std::int64_t k) {
+    // Longer than the small string buffer, so that copies allocate
+    return {std::string(32 + k % 8, static_cast<char>('a' + k % 26))};
+}
+
+template<int I>
+std::int64_t weight(trivial<I> const &p) {
+    return p.value + I;
+}
+
+template<int I>
+std::int64_t weight(nontrivial<I> const &p) {
+    return static_cast<std::int64_t>(p.value.size()) + I;
+}
+
+#define BENCH_INDICES_2(X) X(0) X(1)
+#define BENCH_INDICES_8(X) BENCH_INDICES_2(X) X(2) X(3) X(4) X(5) X(6) X(7)
+#define BENCH_INDICES_32(X)                                                      \
+    BENCH_INDICES_8(X) X(8) X(9) X(10) X(11) X(12) X(13) X(14) X(15) X(16) X(17) \
+    X(18) X(19) X(20) X(21) X(22) X(23) X(24) X(25) X(26) X(27) X(28) X(29) X(30) X(31)
+
+// UNION(payload_n, (payload<0>, a0), ..., (payload<n - 1>, an-1)), and MATCH and MATCH_SWITCH with a CASE per alternative
+
+template<template<int> class P, int N>
+struct tagged_union_for;
+
+#define BENCH_EXPAND_UNION(...) UNION(__VA_ARGS__)
+#define BENCH_EXPAND_MATCH(...) MATCH(__VA_ARGS__)
+#define BENCH_EXPAND_MATCH_SWITCH(...) MATCH_SWITCH(__VA_ARGS__)
+#define BENCH_TRIVIAL_ALTERNATIVE(i) , (trivial<i>, a##i)
+#define BENCH_NONTRIVIAL_ALTERNATIVE(i) , (nontrivial<i>, a##i)
+#define BENCH_MATCH_CASE(i) , CASE(a##i, p, { return weight(p); })
+
+#define BENCH_UNION(payload, n)                                                                \
+    BENCH_EXPAND_UNION(payload##_##n BENCH_INDICES_##n(BENCH_ALTERNATIVE_##payload));          \
+    template<>                                                                                 \
+    struct tagged_union_for<payload, n> {                                                      \
+        using type = payload##_##n;                                                            \
+    };                                                                                         \
+    std::int64_t match_macro(payload##_##n const &u) {                                         \
+        return BENCH_EXPAND_MATCH(std::int64_t, u BENCH_INDICES_##n(BENCH_MATCH_CASE));        \
+    }                                                                                          \
+    std::int64_t match_switch_macro(payload##_##n const &u) {                                  \
+        return BENCH_EXPAND_MATCH_SWITCH(std::int64_t, u BENCH_INDICES_##n(BENCH_MATCH_CASE)); \
+    }
+
+#define BENCH_ALTERNATIVE_trivial BENCH_TRIVIAL_ALTERNATIVE
+#define BENCH_ALTERNATIVE_nontrivial BENCH_NONTRIVIAL_ALTERNATIVE
+
+BENCH_UNION(trivial, 2)
+BENCH_UNION(trivial, 8)
+BENCH_UNION(trivial, 32)
+BENCH_UNION(nontrivial, 2)
+BENCH_UNION(nontrivial, 8)
+BENCH_UNION(nontrivial, 32)
+
+// Matcher with a case_ method for every alternative of the largest union
+#define BENCH_MATCH_METHOD(i)                        \
+    template<typename Payload>                       \
+    std::int64_t case_a##i(Payload const &p) const { \
+        return weight(p);                            \
+    }
+
+struct matcher {
+    BENCH_INDICES_32(BENCH_MATCH_METHOD)
+};
+
+// Hand-written tagged union: an enum tag, an anonymous union and a switch in every special member
+
+#define BENCH_MANUAL_MEMBER(i) P<i> m##i;
+#define BENCH_MANUAL_GET(i) if constexpr (I == i) { return (m##i); } else
+#define BENCH_MANUAL_COPY(i) case i: std::construct_at(&m##i, other.m##i); break;
+#define BENCH_MANUAL_MOVE(i) case i: std::construct_at(&m##i, std::move(other.m##i)); break;
+#define BENCH_MANUAL_ASSIGN(i) case i: m##i = other.m##i; break;
+#define BENCH_MANUAL_DESTROY(i) case i: std::destroy_at(&m##i); break;
+#define BENCH_MANUAL_VISIT(i) case i: return f(m##i);
+
+#define BENCH_MANUAL(n)                                                       \
+    template<template<int> class P>                                           \
+    struct manual_##n {                                                       \
+    public:                                                                   \
+        template<std::size_t I>                                               \
+        manual_##n(std::in_place_index_t<I>, P<static_cast<int>(I)> value)    \
+            : m_tag(I) {                                                      \
+            std::construct_at(&get<static_cast<int>(I)>(), std::move(value)); \
+        }                                                                     \
+                                                                              \
+        manual_##n(manual_##n const &other)                                   \
+            : m_tag(other.m_tag) {                                            \
+            switch (m_tag) { BENCH_INDICES_##n(BENCH_MANUAL_COPY) }           \
+        }                                                                     \
+                                                                              \
+        manual_##n(manual_##n &&other) noexcept                               \
+            : m_tag(other.m_tag) {                                            \
+            switch (m_tag) { BENCH_INDICES_##n(BENCH_MANUAL_MOVE) }           \
+        }                                                                     \
+                                                                              \
+        manual_##n &operator=(manual_##n const &other) {                      \
+            if (m_tag == other.m_tag) {                                       \
+                switch (m_tag) { BENCH_INDICES_##n(BENCH_MANUAL_ASSIGN) }     \
+            } else {                                                          \
+                destroy();                                                    \
+                m_tag = other.m_tag;                                          \
+                switch (m_tag) { BENCH_INDICES_##n(BENCH_MANUAL_COPY) }       \
+            }                                                                 \
+            return *this;                                                     \
+        }                                                                     \
+                                                                              \
+        ~manual_##n() {                                                       \
+            destroy();                                                        \
+        }                                                                     \
+                                                                              \
+        template<int I>                                                       \
+        void emplace(P<I> value) {                                            \
+            destroy();                                                        \
+            m_tag = I;                                                        \
+            std::construct_at(&get<I>(), std::move(value));                   \
+        }                                                                     \
+                                                                              \
+        template<typename F>                                                  \
+        std::int64_t visit(F &&f) const {                                     \
+            switch (m_tag) { BENCH_INDICES_##n(BENCH_MANUAL_VISIT) }          \
+            __builtin_unreachable();                                          \
+        }                                                                     \
+                                                                              \
+    private:                                                                  \
+        template<int I>                                                       \
+        auto &get() {                                                         \
+            BENCH_INDICES_##n(BENCH_MANUAL_GET) { static_assert(I < n); }     \
+        }                                                                     \
+                                                                              \
+        void destroy() noexcept {                                             \
+            switch (m_tag) { BENCH_INDICES_##n(BENCH_MANUAL_DESTROY) }        \
+        }                                                                     \
+                                                                              \
+        std::uint8_t m_tag;                                                   \
+        union {                                                               \
+            BENCH_INDICES_##n(BENCH_MANUAL_MEMBER)                            \
+        };                                                                    \
+    };
+
+BENCH_MANUAL(2)
+BENCH_MANUAL(8)
+BENCH_MANUAL(32)
+
+template<template<int> class P, int N>
+struct manual_for;
+
+template<template<int> class P>
+struct manual_for<P, 2> {
+    using type = manual_2<P>;
+};
+
+template<template<int> class P>
+struct manual_for<P, 8> {
+    using type = manual_8<P>;
+};
+
+template<template<int> class P>
+struct manual_for<P, 32> {
+    using type = manual_32<P>;
+};
+
+template<template<int> class P, typename Indices>
+struct variant_for;
+
+template<template<int> class P, int... Is>
+struct variant_for<P, std::integer_sequence<int, Is...>> {
+    using type = std::variant<P<Is>...>;
+};
+
+// Subjects adapt the three implementations to one interface: type, make<I>(payload), emplace<I>(object, payload)
+// and visit(object, f)
+
+template<template<int> class P, int N>
+struct tagged_subject {
+    using type = typename tagged_union_for<P, N>::type;
+
+    static constexpr char const *name = "UNION";
+
+    template<int I>
+    static type make(P<I> payload) {
+        return type::template create<static_cast<typename type::tag_t>(I)>(std::move(payload));
+    }
+
+    template<int I>
+    static void emplace(type &object, P<I> payload) {
+        object.template emplace<static_cast<typename type::tag_t>(I)>(std::move(payload));
+    }
+
+    template<typename F>
+    static std::int64_t visit(type const &object, F &&f) {
+        return object.template visit<std::int64_t>([&](auto, auto const &payload) { return f(payload); });
+    }
+};
+
+template<template<int> class P, int N>
+struct variant_subject {
+    using type = typename variant_for<P, std::make_integer_sequence<int, N>>::type;
+
+    static constexpr char const *name = "std::variant";
+
+    template<int I>
+    static type make(P<I> payload) {
+        return type(std::in_place_index<I>, std::move(payload));
+    }
+
+    template<int I>
+    static void emplace(type &object, P<I> payload) {
+        object.template emplace<I>(std::move(payload));
+    }
+
+    template<typename F>
+    static std::int64_t visit(type const &object, F &&f) {
+        return std::visit(f, object);
+    }
+};
+
+template<template<int> class P, int N>
+struct manual_subject {
+    using type = typename manual_for<P, N>::type;
+
+    static constexpr char const *name = "manual";
+
+    template<int I>
+    static type make(P<I> payload) {
+        return type(std::in_place_index<I>, std::move(payload));
+    }
+
+    template<int I>
+    static void emplace(type &object, P<I> payload) {
+        object.template emplace<I>(std::move(payload));
+    }
+
+    template<typename F>
+    static std::int64_t visit(type const &object, F &&f) {
+        return object.visit(f);
+    }
+};
+
+inline constexpr std::size_t input_size = 1024;
+
+template<template<template<int> class, int> class Subject, template<int> class P, int N>
+struct inputs {
+    using subject = Subject<P, N>;
+    using type = typename subject::type;
+
+    template<int I>
+    using payload = P<I>;
+
+    // Objects holding alternative (i + shift) % N for uniformly distributed i
+    static std::vector<type> make(int shift = 0) {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> kind(0, N - 1);
+        std::vector<type> objects;
+        objects.reserve(input_size);
+        for (std::size_t k = 0; k < input_size; ++k) {
+            objects.push_back(make_one((kind(rng) + shift) % N, static_cast<std::int64_t>(k), std::make_integer_sequence<int, N>()));
+        }
+        return objects;
+    }
+
+    template<int... Is>
+    static type make_one(int index, std::int64_t k, std::integer_sequence<int, Is...>) {
+        static constexpr type (*makers[])(std::int64_t) = {+[](std::int64_t k) { return subject::template make<Is>(make_payload(std::type_identity<P<Is>>(), k)); }...};
+        return makers[index](k);
+    }
+};
+
+// Payload of alternative 0, for the benchmarks that construct or emplace
+template<typename Inputs>
+auto first_payload(std::int64_t k) {
+    return make_payload(std::type_identity<typename Inputs::template payload<0>>(), k);
+}
+
+template<typename Inputs>
+auto second_payload(std::int64_t k) {
+    return make_payload(std::type_identity<typename Inputs::template payload<1>>(), k);
+}
+
+template<typename Inputs>
+void construct(benchmark::State &state) {
+    using subject = typename Inputs::subject;
+    auto payload = first_payload<Inputs>(7);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < input_size; ++i) {
+            auto object = subject::template make<0>(payload);
+            benchmark::DoNotOptimize(object);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * input_size);
+}
+
+template<typename Inputs>
+void copy(benchmark::State &state) {
+    auto source = Inputs::make();
+    for (auto _ : state) {
+        for (auto const &object : source) {
+            typename Inputs::type copy(object);
+            benchmark::DoNotOptimize(copy);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * input_size);
+}
+
+// Moves every element between two buffers, destroying the moved-from element of the previous round
+template<typename Inputs>
+void move(benchmark::State &state) {
+    using type = typename Inputs::type;
+    auto front = Inputs::make(), back = Inputs::make();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < input_size; ++i) {
+            std::destroy_at(&back[i]);
+            std::construct_at(&back[i], std::move(front[i]));
+        }
+        std::swap(front, back);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * input_size);
+    static_assert(std::is_nothrow_move_constructible_v<type>);
+}
+
+template<typename Inputs>
+void assign_same(benchmark::State &state) {
+    auto source = Inputs::make(), target = Inputs::make();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < input_size; ++i) {
+            target[i] = source[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * input_size);
+}
+
+// Every assignment switches the alternative, between the inputs and the inputs shifted by one alternative
+template<typename Inputs>
+void assign_different(benchmark::State &state) {
+    auto source = Inputs::make(), shifted = Inputs::make(1), target = Inputs::make();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < input_size; ++i) {
+            target[i] = shifted[i];
+            target[i] = source[i];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * input_size * 2);
+}
+
+// Every emplace switches the alternative, between alternatives 0 and 1
+template<typename Inputs>
+void emplace(benchmark::State &state) {
+    using subject = typename Inputs::subject;
+    auto target = Inputs::make();
+    auto first = first_payload<Inputs>(7);
+    auto second = second_payload<Inputs>(9);
+    for (auto _ : state) {
+        for (auto &object : target) {
+            subject::template emplace<0>(object, first);
+            subject::template emplace<1>(object, second);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * input_size * 2);
+}
+
+template<typename Inputs>
+void visit(benchmark::State &state) {
+    using subject = typename Inputs::subject;
+    auto source = Inputs::make();
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (auto const &object : source) {
+            sum += subject::visit(object, [](auto const &payload) { return weight(payload); });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * input_size);
+}
+
+template<typename Inputs>
+void match(benchmark::State &state) {
+    auto source = Inputs::make();
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (auto const &object : source) {
+            sum += object.template match<std::int64_t>(matcher{});
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * input_size);
+}
+
+template<typename Inputs>
+void match_macro(benchmark::State &state) {
+    auto source = Inputs::make();
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (auto const &object : source) {
+            sum += match_macro(object);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * input_size);
+}
+
+template<typename Inputs>
+void match_switch_macro(benchmark::State &state) {
+    auto source = Inputs::make();
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (auto const &object : source) {
+            sum += match_switch_macro(object);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * input_size);
+}
+
+// Benchmarks are named operation/implementation/payload/alternatives, e.g. copy/std::variant/nontrivial/8
+template<template<template<int> class, int> class Subject, template<int> class P, int N>
+void register_subject(char const *payload) {
+    using in = inputs<Subject, P, N>;
+    auto add = [&](char const *operation, void (*function)(benchmark::State &)) {
+        std::string name = std::string(operation) + "/" + Subject<P, N>::name + "/" + payload + "/" + std::to_string(N);
+        benchmark::RegisterBenchmark(name.c_str(), function);
+    };
+    add("construct", construct<in>);
+    add("copy", copy<in>);
+    add("move", move<in>);
+    add("assign_same", assign_same<in>);
+    add("assign_different", assign_different<in>);
+    add("emplace", emplace<in>);
+    add("visit", visit<in>);
+    if constexpr (std::is_same_v<Subject<P, N>, tagged_subject<P, N>>) {
+        add("match", match<in>);
+        add("MATCH", match_macro<in>);
+        add("MATCH_SWITCH", match_switch_macro<in>);
+    }
+}
+
+template<template<int> class P, int N>
+void register_alternatives(char const *payload) {
+    register_subject<tagged_subject, P, N>(payload);
+    register_subject<variant_subject, P, N>(payload);
+    register_subject<manual_subject, P, N>(payload);
+}
+
+int main(int argc, char **argv) {
+    register_alternatives<trivial, 2>("trivial");
+    register_alternatives<trivial, 8>("trivial");
+    register_alternatives<trivial, 32>("trivial");
+    register_alternatives<nontrivial, 2>("nontrivial");
+    register_alternatives<nontrivial, 8>("nontrivial");
+    register_alternatives<nontrivial, 32>("nontrivial");
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+}
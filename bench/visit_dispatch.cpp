@@ -0,0 +1,140 @@
+#include "../tagged_union.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+UNION(Node
+    , (std::int64_t, integer)
+    , (double, number)
+    , (bool, boolean)
+    , (std::int32_t, symbol)
+    , (std::uint16_t, opcode)
+    , (float, weight)
+    , (char, character)
+    , (struct {}, nil)
+);
+
+// The same alternatives, with a profile that matches the skewed input
+UNION(ProfiledNode
+    , (std::int64_t, integer)
+    , (double, number)
+    , (bool, boolean)
+    , (std::int32_t, symbol)
+    , (std::uint16_t, opcode)
+    , (float, weight)
+    , (char, character)
+    , (struct {}, nil)
+);
+
+template<>
+struct tu::dispatch_profile<ProfiledNode> {
+    static constexpr std::array<std::uint64_t, ProfiledNode::alternative_count> frequencies = {90, 2, 2, 2, 1, 1, 1, 1};
+};
+
+struct Eval {
+    std::int64_t operator()(tu::in_place_tag_t<Node::tag_t::integer>, std::int64_t i) const { return i; }
+    std::int64_t operator()(tu::in_place_tag_t<Node::tag_t::number>, double d) const { return static_cast<std::int64_t>(d); }
+    std::int64_t operator()(tu::in_place_tag_t<Node::tag_t::boolean>, bool b) const { return b; }
+    std::int64_t operator()(tu::in_place_tag_t<Node::tag_t::symbol>, std::int32_t s) const { return s * 3; }
+    std::int64_t operator()(tu::in_place_tag_t<Node::tag_t::opcode>, std::uint16_t o) const { return o ^ 0x55; }
+    std::int64_t operator()(tu::in_place_tag_t<Node::tag_t::weight>, float w) const { return static_cast<std::int64_t>(w * 2); }
+    std::int64_t operator()(tu::in_place_tag_t<Node::tag_t::character>, char c) const { return c; }
+    std::int64_t operator()(tu::in_place_tag_t<Node::tag_t::nil>, auto const &) const { return 0; }
+};
+
+struct ProfiledEval {
+    template<auto tag, typename T>
+    std::int64_t operator()(tu::in_place_tag_t<tag>, T const &value) const {
+        return Eval{}(tu::in_place_tag<static_cast<Node::tag_t>(tag)>, value);
+    }
+};
+
+// `skew` is the percentage of nodes holding `integer`, the rest are spread uniformly
+static std::vector<Node> make_nodes(int skew) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> percent(0, 99), kind(0, 7);
+    std::vector<Node> nodes;
+    for (int i = 0; i < 4096; ++i) {
+        switch (percent(rng) < skew ? 0 : kind(rng)) {
+        case 0: nodes.push_back(Node::create_integer(i)); break;
+        case 1: nodes.push_back(Node::create_number(i * 0.5)); break;
+        case 2: nodes.push_back(Node::create_boolean(i & 1)); break;
+        case 3: nodes.push_back(Node::create_symbol(i)); break;
+        case 4: nodes.push_back(Node::create_opcode(static_cast<std::uint16_t>(i))); break;
+        case 5: nodes.push_back(Node::create_weight(i * 0.25f)); break;
+        case 6: nodes.push_back(Node::create_character(static_cast<char>(i))); break;
+        default: nodes.push_back(Node::create_nil()); break;
+        }
+    }
+    return nodes;
+}
+
+static std::vector<ProfiledNode> make_profiled_nodes(int skew) {
+    std::vector<ProfiledNode> nodes;
+    for (auto const &node : make_nodes(skew)) {
+        node.visit<void>([&](auto tag, auto const &value) {
+            constexpr auto profiled_tag = static_cast<ProfiledNode::tag_t>(decltype(tag)::value);
+            if constexpr (std::is_empty_v<std::remove_cvref_t<decltype(value)>>) {
+                nodes.push_back(ProfiledNode::create<profiled_tag>());
+            } else {
+                nodes.push_back(ProfiledNode::create<profiled_tag>(value));
+            }
+        });
+    }
+    return nodes;
+}
+
+static void visit_switch(benchmark::State &state) {
+    auto nodes = make_nodes(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (auto const &node : nodes) {
+            sum += node.visit<std::int64_t>(Eval{});
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+
+static void visit_table(benchmark::State &state) {
+    auto nodes = make_nodes(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (auto const &node : nodes) {
+            sum += node.visit_table<std::int64_t>(Eval{});
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+
+static void visit_expect(benchmark::State &state) {
+    auto nodes = make_nodes(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (auto const &node : nodes) {
+            sum += node.visit_expect<Node::tag_t::integer, std::int64_t>(Eval{});
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+
+static void visit_profiled(benchmark::State &state) {
+    auto nodes = make_profiled_nodes(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (auto const &node : nodes) {
+            sum += node.visit<std::int64_t>(ProfiledEval{});
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+
+BENCHMARK(visit_switch)->Arg(0)->Arg(90);
+BENCHMARK(visit_table)->Arg(0)->Arg(90);
+BENCHMARK(visit_expect)->Arg(0)->Arg(90);
+BENCHMARK(visit_profiled)->Arg(0)->Arg(90);
+
+BENCHMARK_MAIN();
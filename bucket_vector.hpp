@@ -0,0 +1,88 @@
+#pragma once
+
+#include "tagged_union.hpp"
+
+#include <vector>
+
+namespace tu {
+// Unordered collection of unions that stores each alternative in its own std::vector,
+// so that visiting runs one loop per alternative instead of dispatching on every element
+template<typename Union>
+struct bucket_vector : public Union::template named_push_back<bucket_vector<Union>> {
+public:
+    using union_type = Union;
+    using tag_t = typename Union::tag_t;
+
+    template<tag_t tag>
+    using alternative_t = typename Union::template alternative_t<tag>;
+
+    std::size_t size() const noexcept {
+        return std::apply([](auto const &...buckets) { return (buckets.size() + ... + std::size_t(0)); }, m_buckets);
+    }
+
+    bool empty() const noexcept {
+        return std::apply([](auto const &...buckets) { return (buckets.empty() && ...); }, m_buckets);
+    }
+
+    void clear() noexcept {
+        std::apply([](auto &...buckets) { (buckets.clear(), ...); }, m_buckets);
+    }
+
+    template<tag_t tag, typename... Args>
+    alternative_t<tag> &emplace_back(Args &&...args) {
+        return bucket<tag>().emplace_back(std::forward<Args>(args)...);
+    }
+
+    template<typename U>
+        requires std::is_same_v<std::remove_cvref_t<U>, Union>
+    void push_back(U &&value) {
+        std::forward<U>(value).template visit_table<void>([this](auto tag, auto &&alternative) {
+            emplace_back<decltype(tag)::value>(std::forward<decltype(alternative)>(alternative));
+        });
+    }
+
+    template<tag_t tag>
+    std::vector<alternative_t<tag>> &bucket() noexcept {
+        return std::get<static_cast<std::size_t>(tag)>(m_buckets);
+    }
+
+    template<tag_t tag>
+    std::vector<alternative_t<tag>> const &bucket() const noexcept {
+        return std::get<static_cast<std::size_t>(tag)>(m_buckets);
+    }
+
+    template<tag_t tag>
+    std::size_t count() const noexcept {
+        return bucket<tag>().size();
+    }
+
+    // Calls visitor(tu::in_place_tag<tag>, value) for every element, bucket by bucket in tag order.
+    // Buckets whose alternative the visitor does not accept are skipped at compile time.
+    template<typename Visitor>
+    void visit_all(Visitor &&visitor) {
+        visit_all_impl(*this, visitor, std::make_index_sequence<Union::alternative_count>{});
+    }
+
+    template<typename Visitor>
+    void visit_all(Visitor &&visitor) const {
+        visit_all_impl(*this, visitor, std::make_index_sequence<Union::alternative_count>{});
+    }
+
+private:
+    template<typename Self, typename Visitor, std::size_t... index>
+    static void visit_all_impl(Self &self, Visitor &visitor, std::index_sequence<index...>) {
+        (visit_bucket<static_cast<tag_t>(index)>(self.template bucket<static_cast<tag_t>(index)>(), visitor), ...);
+    }
+
+    template<tag_t tag, typename Bucket, typename Visitor>
+    static void visit_bucket(Bucket &bucket, Visitor &visitor) {
+        if constexpr (requires { visitor(tu::in_place_tag<tag>, bucket.front()); }) {
+            for (auto &value : bucket) {
+                visitor(tu::in_place_tag<tag>, value);
+            }
+        }
+    }
+
+    typename detail::alternative_columns<Union, std::vector>::type m_buckets;
+};
+}
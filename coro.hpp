@@ -0,0 +1,294 @@
+#pragma once
+
+#include "tagged_union.hpp"
+
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <new>
+#include <optional>
+
+namespace tu {
+// Per-thread free list of coroutine frames for the handlers of one union type. Every block has the size of the largest
+// frame requested on the thread so far, so once each handler has run a frame is recycled instead of allocated. Frames
+// may be freed on another thread than the one that allocated them, and then go to that thread's list.
+template<typename Union>
+struct frame_pool {
+public:
+    static void *allocate(std::size_t size) {
+        cache &local = cache::get();
+        if (size > local.m_block_size) {
+            local.clear();
+            local.m_block_size = (size + header_size - 1) / header_size * header_size;
+        } else if (local.m_free) {
+            block *frame = local.m_free;
+            local.m_free = frame->m_next;
+            --local.m_count;
+            return frame->data();
+        }
+        auto *frame = static_cast<block *>(::operator new(header_size + local.m_block_size));
+        frame->m_capacity = local.m_block_size;
+        return frame->data();
+    }
+
+    static void deallocate(void *data) noexcept {
+        auto *frame = reinterpret_cast<block *>(static_cast<std::byte *>(data) - header_size);
+        cache &local = cache::get();
+        if (frame->m_capacity != local.m_block_size) {
+            ::operator delete(frame);
+            return;
+        }
+        frame->m_next = local.m_free;
+        local.m_free = frame;
+        ++local.m_count;
+    }
+
+    // Size of the blocks cached by the calling thread, and how many are free
+    static std::size_t block_size() noexcept {
+        return cache::get().m_block_size;
+    }
+
+    static std::size_t cached() noexcept {
+        return cache::get().m_count;
+    }
+
+    // Frees the blocks cached by the calling thread
+    static void release() noexcept {
+        cache::get().clear();
+    }
+
+private:
+    // The header keeps the frame at the alignment of ::operator new
+    static constexpr std::size_t header_size = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    struct block {
+        std::byte *data() noexcept {
+            return reinterpret_cast<std::byte *>(this) + header_size;
+        }
+
+        std::size_t m_capacity;
+        block *m_next;
+    };
+
+    static_assert(sizeof(block) <= header_size);
+
+    struct cache {
+        static cache &get() noexcept {
+            thread_local cache local;
+            return local;
+        }
+
+        void clear() noexcept {
+            while (m_free) {
+                block *next = m_free->m_next;
+                ::operator delete(m_free);
+                m_free = next;
+            }
+            m_count = 0;
+        }
+
+        ~cache() {
+            clear();
+        }
+
+        block *m_free = nullptr;
+        std::size_t m_block_size = 0;
+        std::size_t m_count = 0;
+    };
+};
+
+template<typename ReturnType, typename Union>
+struct async_task;
+
+namespace detail {
+template<typename ReturnType>
+struct async_promise_result {
+    template<typename T>
+    void return_value(T &&value) {
+        m_value.emplace(std::forward<T>(value));
+    }
+
+    ReturnType take() {
+        return std::move(*m_value);
+    }
+
+    std::optional<ReturnType> m_value;
+};
+
+template<>
+struct async_promise_result<void> {
+    void return_void() noexcept {}
+
+    void take() noexcept {}
+};
+}
+
+// Lazily started coroutine producing ReturnType, whose frame comes from tu::frame_pool<Union>. Awaiting it starts it
+// by symmetric transfer, and it resumes the awaiting coroutine the same way when it completes.
+template<typename ReturnType, typename Union>
+struct [[nodiscard]] async_task {
+public:
+    struct promise_type : detail::async_promise_result<ReturnType> {
+        static void *operator new(std::size_t size) {
+            return frame_pool<Union>::allocate(size);
+        }
+
+        static void operator delete(void *frame) noexcept {
+            frame_pool<Union>::deallocate(frame);
+        }
+
+        async_task get_return_object() noexcept {
+            return async_task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        auto final_suspend() noexcept {
+            struct resume_continuation {
+                bool await_ready() noexcept {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> self) noexcept {
+                    return self.promise().m_continuation ? self.promise().m_continuation : std::noop_coroutine();
+                }
+
+                void await_resume() noexcept {}
+            };
+            return resume_continuation{};
+        }
+
+        void unhandled_exception() noexcept {
+            m_exception = std::current_exception();
+        }
+
+        std::coroutine_handle<> m_continuation;
+        std::exception_ptr m_exception;
+    };
+
+    async_task(async_task &&other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+    async_task &operator=(async_task &&other) noexcept {
+        std::swap(m_handle, other.m_handle);
+        return *this;
+    }
+
+    ~async_task() {
+        if (m_handle) {
+            m_handle.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        m_handle.promise().m_continuation = awaiting;
+        return m_handle;
+    }
+
+    ReturnType await_resume() {
+        if (m_handle.promise().m_exception) {
+            std::rethrow_exception(m_handle.promise().m_exception);
+        }
+        return m_handle.promise().take();
+    }
+
+private:
+    explicit async_task(std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {}
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+namespace detail {
+template<typename ReturnType, typename Union, typename Awaitable>
+async_task<ReturnType, Union> await_into_task(Awaitable awaitable) {
+    co_return co_await std::move(awaitable);
+}
+}
+
+// Result of co_visit and async_match: either the value of an arm that returned synchronously, which is ready without
+// suspending or allocating, or the coroutine the arm returned. Arms may return ReturnType (nothing for void), a
+// tu::async_task<ReturnType, Union>, or any other awaitable, which is awaited from a frame of the pool.
+template<typename ReturnType, typename Union>
+struct [[nodiscard]] async_result {
+public:
+    using task_type = async_task<ReturnType, Union>;
+
+    async_result()
+        requires std::is_void_v<ReturnType>
+    = default;
+
+    template<typename T>
+        requires(!std::is_void_v<ReturnType> && std::is_convertible_v<T, ReturnType>)
+    async_result(T &&value) : m_value(std::in_place, std::forward<T>(value)) {}
+
+    async_result(task_type &&task) noexcept : m_task(std::move(task)) {}
+
+    template<typename Awaitable>
+        requires(!std::is_convertible_v<Awaitable, ReturnType> && !std::is_same_v<std::remove_cvref_t<Awaitable>, task_type> && requires(Awaitable &awaitable) { awaitable.await_ready(); })
+    async_result(Awaitable &&awaitable)
+        : m_task(detail::await_into_task<ReturnType, Union>(std::forward<Awaitable>(awaitable))) {}
+
+    bool await_ready() const noexcept {
+        return !m_task;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        return m_task->await_suspend(awaiting);
+    }
+
+    ReturnType await_resume() {
+        if (m_task) {
+            return m_task->await_resume();
+        }
+        if constexpr (!std::is_void_v<ReturnType>) {
+            return std::move(*m_value);
+        }
+    }
+
+private:
+    std::optional<std::conditional_t<std::is_void_v<ReturnType>, bool, ReturnType>> m_value;
+    std::optional<task_type> m_task;
+};
+
+namespace detail {
+// Visitor for visit<async_result> that passes the arguments on to the user's visitor, keeping its overloads visible
+// to visit, and turns a void arm into a ready result
+template<typename ReturnType, typename Union, typename Visitor>
+struct async_visitor {
+    template<typename... Args>
+        requires std::invocable<Visitor, Args...>
+    async_result<ReturnType, Union> operator()(Args &&...args) const {
+        if constexpr (std::is_void_v<std::invoke_result_t<Visitor, Args...>>) {
+            std::forward<Visitor>(m_visitor)(std::forward<Args>(args)...);
+            return {};
+        } else {
+            return std::forward<Visitor>(m_visitor)(std::forward<Args>(args)...);
+        }
+    }
+
+    Visitor &&m_visitor;
+};
+}
+
+// Dispatches on the tag like visit and returns one awaitable for whatever the selected arm returns. Arms that complete
+// synchronously by returning a value cost no coroutine frame; coroutine arms returning tu::async_task<ReturnType, U>
+// get theirs from tu::frame_pool<U>. The union and the visitor must outlive the co_await, which is the case when the
+// result is awaited in the same full-expression.
+template<typename ReturnType, typename U, typename Visitor>
+async_result<ReturnType, std::remove_cvref_t<U>> co_visit(U &&value, Visitor &&visitor) {
+    using union_t = std::remove_cvref_t<U>;
+    return std::forward<U>(value).template visit<async_result<ReturnType, union_t>>(detail::async_visitor<ReturnType, union_t, Visitor>{std::forward<Visitor>(visitor)});
+}
+
+// The same for match: the case_<field> methods and otherwise of the matcher return ReturnType, a
+// tu::async_task<ReturnType, U> or another awaitable
+template<typename ReturnType, typename U, typename Matcher>
+async_result<ReturnType, std::remove_cvref_t<U>> async_match(U &&value, Matcher &&matcher) {
+    return std::forward<U>(value).template match<async_result<ReturnType, std::remove_cvref_t<U>>>(std::forward<Matcher>(matcher));
+}
+}
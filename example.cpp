@@ -44,6 +44,7 @@ int main() {
     MATCH(void, u
         , CASE(name, name, { std::cout << "Name: " << name << std::endl; })
         , CASE(index, idx, { std::cout << "Index: " << idx << std::endl; })
+        , OTHERWISE(_, {})
     );
 
     auto a = MATCH(int, u
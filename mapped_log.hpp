@@ -0,0 +1,277 @@
+#pragma once
+
+#include "serialize.hpp"
+
+#include <filesystem>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tu {
+namespace detail {
+// Shared mapping of a whole file that grows the file on demand (POSIX)
+struct mapped_file {
+public:
+    mapped_file(std::filesystem::path const &path, bool writable)
+        : m_writable(writable) {
+        m_fd = ::open(path.c_str(), writable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+        if (m_fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path.string());
+        }
+        struct stat st;
+        if (::fstat(m_fd, &st) != 0) {
+            int error = errno;
+            ::close(m_fd);
+            throw std::system_error(error, std::generic_category(), "fstat " + path.string());
+        }
+        m_size = static_cast<std::size_t>(st.st_size);
+        try {
+            map(m_size);
+        } catch (...) {
+            ::close(m_fd);
+            throw;
+        }
+    }
+
+    mapped_file(mapped_file &&other) noexcept
+        : m_fd(std::exchange(other.m_fd, -1)), m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)), m_writable(other.m_writable) {}
+
+    mapped_file &operator=(mapped_file other) noexcept {
+        std::swap(m_fd, other.m_fd);
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_writable, other.m_writable);
+        return *this;
+    }
+
+    ~mapped_file() {
+        if (m_data) {
+            ::munmap(m_data, m_size);
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+
+    std::byte *data() const noexcept {
+        return m_data;
+    }
+
+    std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    // Grows the file geometrically so that at least size bytes are mapped
+    void reserve(std::size_t size) {
+        assert(m_writable && "read-only mapping");
+        if (size <= m_size) {
+            return;
+        }
+        std::size_t grown = std::max({size, m_size * 2, std::size_t(1) << 16});
+        if (::ftruncate(m_fd, static_cast<off_t>(grown)) != 0) {
+            throw std::system_error(errno, std::generic_category(), "ftruncate");
+        }
+        if (m_data) {
+            ::munmap(m_data, m_size);
+            m_data = nullptr;
+        }
+        m_size = grown;
+        map(m_size);
+    }
+
+    void sync() {
+        if (m_data && ::msync(m_data, m_size, MS_SYNC) != 0) {
+            throw std::system_error(errno, std::generic_category(), "msync");
+        }
+    }
+
+private:
+    void map(std::size_t size) {
+        if (size == 0) {
+            return;
+        }
+        void *data = ::mmap(nullptr, size, m_writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, m_fd, 0);
+        if (data == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        m_data = static_cast<std::byte *>(data);
+    }
+
+    int m_fd = -1;
+    std::byte *m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_writable;
+};
+}
+
+// Append-only log of serialized unions in a memory-mapped file, with a side index of record offsets per tag
+// in `<path>.index`, so that replaying the records of one alternative never touches the others.
+// Records are read in place through tu::view, without parsing or allocation.
+template<typename Union>
+struct mapped_log {
+public:
+    using union_type = Union;
+    using tag_t = typename Union::tag_t;
+
+    // Opens the log at path, creating it if it does not exist and writable is set
+    explicit mapped_log(std::filesystem::path const &path, bool writable = true)
+        : m_data(path, writable), m_index(std::filesystem::path(path) += ".index", writable) {
+        if (m_data.size() == 0 && m_index.size() == 0 && writable) {
+            m_data.reserve(header_size);
+            m_index.reserve(header_size);
+            std::memcpy(m_data.data(), magic, sizeof(magic));
+            std::memcpy(m_index.data(), magic, sizeof(magic));
+            store_word(m_data, header_size);
+            store_word(m_index, 0);
+        }
+        auto reject = [&] {
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument), "not a tagged union log: " + path.string());
+        };
+        if (m_data.size() < header_size || m_index.size() < header_size ||
+            std::memcmp(m_data.data(), magic, sizeof(magic)) != 0 || std::memcmp(m_index.data(), magic, sizeof(magic)) != 0) {
+            reject();
+        }
+        m_end = load_word(m_data);
+        std::uint64_t count = load_word(m_index);
+        if (m_end < header_size || m_end > m_data.size() || count > (m_index.size() - header_size) / sizeof(std::uint64_t)) {
+            reject();
+        }
+        m_count = static_cast<std::size_t>(count);
+        // A record is only visible once both the data and its index entry have been written
+        while (m_count > 0 && (entry(m_count - 1) & offset_mask) >= m_end) {
+            --m_count;
+        }
+        // Every visible record must lie within the data, so that at() may trust the offsets and lengths
+        for (std::size_t i = 0; i < m_count; ++i) {
+            std::uint64_t e = entry(i);
+            std::uint64_t offset = e & offset_mask;
+            if ((e >> tag_shift) >= Union::alternative_count || offset < header_size || offset > m_end - sizeof(std::uint64_t)) {
+                reject();
+            }
+            std::uint64_t length;
+            std::memcpy(&length, m_data.data() + offset, sizeof(length));
+            std::uint64_t payload = align_up(offset + sizeof(std::uint64_t), record_align);
+            if (payload > m_end || length > m_end - payload) {
+                reject();
+            }
+            m_offsets[e >> tag_shift].push_back(offset);
+        }
+    }
+
+    // Number of records
+    std::size_t size() const noexcept {
+        return m_count;
+    }
+
+    bool empty() const noexcept {
+        return m_count == 0;
+    }
+
+    void append(Union const &value) {
+        std::size_t length = serialized_size(value);
+        std::uint64_t offset = m_end;
+        std::uint64_t payload = align_up(offset + sizeof(std::uint64_t), record_align);
+        std::uint64_t next = align_up(payload + length, sizeof(std::uint64_t));
+        assert(next <= offset_mask && "log too large");
+        m_data.reserve(next);
+        m_index.reserve(header_size + (m_count + 1) * sizeof(std::uint64_t));
+
+        std::memcpy(m_data.data() + offset, &length, sizeof(std::uint64_t));
+        serialize(value, std::span<std::byte>(m_data.data() + payload, length));
+        m_end = next;
+        store_word(m_data, m_end);
+
+        std::uint64_t e = offset | std::uint64_t(static_cast<std::size_t>(value.get_tag())) << tag_shift;
+        std::memcpy(m_index.data() + header_size + m_count * sizeof(std::uint64_t), &e, sizeof(e));
+        m_offsets[static_cast<std::size_t>(value.get_tag())].push_back(offset);
+        store_word(m_index, ++m_count);
+    }
+
+    // Flushes the mapped files to storage
+    void sync() {
+        m_data.sync();
+        m_index.sync();
+    }
+
+    // View of the i-th record
+    view<Union> operator[](std::size_t i) const noexcept {
+        assert(i < m_count && "record index out of range");
+        return at(entry(i) & offset_mask);
+    }
+
+    // View of the record at the given offset, as returned by offsets()
+    view<Union> at(std::uint64_t offset) const noexcept {
+        assert(offset >= header_size && offset < m_end && "not the offset of a record");
+        std::uint64_t length;
+        std::memcpy(&length, m_data.data() + offset, sizeof(length));
+        std::uint64_t payload = align_up(offset + sizeof(std::uint64_t), record_align);
+        return view<Union>(std::span<std::byte const>(m_data.data() + payload, length));
+    }
+
+    template<tag_t tag>
+    std::span<std::uint64_t const> offsets() const noexcept {
+        return m_offsets[static_cast<std::size_t>(tag)];
+    }
+
+    // Calls f(view) for every record, in order
+    template<typename F>
+    void for_each(F &&f) const {
+        for (std::size_t i = 0; i < m_count; ++i) {
+            f((*this)[i]);
+        }
+    }
+
+    // Calls f(value) for every record holding tag, in order, reading only those records.
+    // Throws std::system_error if a record is malformed or does not hold tag.
+    template<tag_t tag, typename F>
+    void for_each(F &&f) const {
+        for (std::uint64_t offset : offsets<tag>()) {
+            if (view<Union> record = at(offset); !record.valid() || !record.template holds<tag>()) {
+                throw std::system_error(std::make_error_code(std::errc::invalid_argument), "malformed tagged union log record");
+            }
+            if constexpr (serializer<typename Union::template alternative_t<tag>>::trivial) {
+                f(at(offset).template get_ref<tag>());
+            } else {
+                f(at(offset).load().template get_ref<tag>());
+            }
+        }
+    }
+
+private:
+    static constexpr char magic[8] = {'T', 'U', 'L', 'O', 'G', '0', '0', '1'};
+    static constexpr std::size_t header_size = 64;
+    static constexpr std::size_t record_align = std::max(alignof(Union), alignof(std::uint64_t));
+    static constexpr unsigned tag_shift = 56;
+    static constexpr std::uint64_t offset_mask = (std::uint64_t(1) << tag_shift) - 1;
+
+    static std::uint64_t align_up(std::uint64_t value, std::size_t align) noexcept {
+        return (value + align - 1) / align * align;
+    }
+
+    // The word after the magic holds the end of the data, or the number of index entries
+    static std::uint64_t load_word(detail::mapped_file const &file) noexcept {
+        std::uint64_t word;
+        std::memcpy(&word, file.data() + sizeof(magic), sizeof(word));
+        return word;
+    }
+
+    static void store_word(detail::mapped_file &file, std::uint64_t word) noexcept {
+        std::memcpy(file.data() + sizeof(magic), &word, sizeof(word));
+    }
+
+    std::uint64_t entry(std::size_t i) const noexcept {
+        std::uint64_t e;
+        std::memcpy(&e, m_index.data() + header_size + i * sizeof(e), sizeof(e));
+        return e;
+    }
+
+    detail::mapped_file m_data;
+    detail::mapped_file m_index;
+    std::uint64_t m_end = 0;
+    std::size_t m_count = 0;
+    std::array<std::vector<std::uint64_t>, Union::alternative_count> m_offsets;
+};
+}
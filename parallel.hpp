@@ -0,0 +1,182 @@
+#pragma once
+
+#include "tag_scan.hpp"
+
+#include <atomic>
+#include <exception>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+namespace tu {
+// Scheduling of parallel_visit. cost[tag] is the relative cost of visiting one element holding tag, which is used to
+// cut every tag group into tasks of about task_cost, so that cheap alternatives get long tasks and expensive ones short
+// tasks and the workers finish at the same time.
+template<typename Union>
+struct parallel_policy {
+    std::size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+    std::size_t task_cost = 4096;
+    std::array<std::size_t, Union::alternative_count> cost = filled(1);
+
+    static constexpr std::array<std::size_t, Union::alternative_count> filled(std::size_t value) noexcept {
+        std::array<std::size_t, Union::alternative_count> costs;
+        costs.fill(value);
+        return costs;
+    }
+};
+
+namespace detail {
+// Elements [begin, end) of the index array, all holding tag
+struct visit_task {
+    std::size_t tag;
+    std::size_t begin;
+    std::size_t end;
+};
+
+// Contiguous block of tasks owned by one worker. The owner takes tasks from the front and other workers steal from
+// the back, both ends live in one word so that either side claims a task with one CAS.
+struct task_deque {
+    static constexpr unsigned shift = 32;
+
+    static std::uint64_t pack(std::uint64_t front, std::uint64_t back) noexcept {
+        return front | back << shift;
+    }
+
+    bool pop_front(std::size_t &task) noexcept {
+        std::uint64_t range = m_range.load(std::memory_order_relaxed);
+        for (;;) {
+            std::uint64_t front = range & 0xffffffff, back = range >> shift;
+            if (front == back) {
+                return false;
+            }
+            if (m_range.compare_exchange_weak(range, pack(front + 1, back), std::memory_order_relaxed)) {
+                task = front;
+                return true;
+            }
+        }
+    }
+
+    bool steal_back(std::size_t &task) noexcept {
+        std::uint64_t range = m_range.load(std::memory_order_relaxed);
+        for (;;) {
+            std::uint64_t front = range & 0xffffffff, back = range >> shift;
+            if (front == back) {
+                return false;
+            }
+            if (m_range.compare_exchange_weak(range, pack(front, back - 1), std::memory_order_relaxed)) {
+                task = back - 1;
+                return true;
+            }
+        }
+    }
+
+    alignas(64) std::atomic<std::uint64_t> m_range{0};
+};
+}
+
+// Calls visitor(tu::in_place_tag<tag>, value) for every element of a contiguous range of unions, on
+// policy.threads threads, in no particular order. The elements are grouped by tag first, so that every task runs a
+// loop over a single alternative. Alternatives the visitor does not accept are passed as the union itself, as by
+// visit_table. The visitor must be safe to call concurrently; the first exception it throws is rethrown.
+template<std::ranges::contiguous_range Range, typename Visitor>
+void parallel_visit(Range &&range, Visitor &&visitor, parallel_policy<std::remove_cv_t<std::ranges::range_value_t<Range>>> const &policy = {}) {
+    using union_t = std::remove_cv_t<std::ranges::range_value_t<Range>>;
+    using tag_t = typename union_t::tag_t;
+    constexpr std::size_t alternatives = union_t::alternative_count;
+    auto *elements = std::ranges::data(range);
+    std::size_t size = std::ranges::size(range);
+    if (size == 0) {
+        return;
+    }
+
+    // Group the indices by tag with a counting sort, sized by the SIMD histogram kernel
+    std::vector<tag_t> tags(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        tags[i] = elements[i].get_tag();
+    }
+    auto counts = tag_histogram<union_t>(tags);
+    std::array<std::size_t, alternatives> starts{};
+    for (std::size_t tag = 1; tag < alternatives; ++tag) {
+        starts[tag] = starts[tag - 1] + counts[tag - 1];
+    }
+    std::vector<std::size_t> indices(size);
+    auto next = starts;
+    for (std::size_t i = 0; i < size; ++i) {
+        indices[next[static_cast<std::size_t>(tags[i])]++] = i;
+    }
+
+    // Tag groups are cut into tasks of about policy.task_cost, and dealt to the workers in whole runs of one tag
+    std::vector<detail::visit_task> tasks;
+    std::size_t total_cost = 0;
+    for (std::size_t tag = 0; tag < alternatives; ++tag) {
+        std::size_t step = std::max<std::size_t>(policy.task_cost / std::max<std::size_t>(policy.cost[tag], 1), 1);
+        for (std::size_t begin = starts[tag]; begin < starts[tag] + counts[tag]; begin += step) {
+            tasks.push_back({tag, begin, std::min(begin + step, starts[tag] + counts[tag])});
+        }
+        total_cost += counts[tag] * policy.cost[tag];
+    }
+    std::size_t workers = std::clamp<std::size_t>(policy.threads, 1, tasks.size());
+    std::vector<detail::task_deque> deques(workers);
+    std::size_t worker = 0, assigned = 0, front = 0;
+    for (std::size_t task = 0; task < tasks.size(); ++task) {
+        auto const &t = tasks[task];
+        assigned += (t.end - t.begin) * policy.cost[t.tag];
+        if (worker + 1 < workers && assigned * workers >= (worker + 1) * total_cost) {
+            deques[worker++].m_range.store(detail::task_deque::pack(front, task + 1), std::memory_order_relaxed);
+            front = task + 1;
+        }
+    }
+    deques[worker].m_range.store(detail::task_deque::pack(front, tasks.size()), std::memory_order_relaxed);
+
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    auto run = [&](detail::visit_task const &t) {
+        detail::dispatch_tag<union_t>(static_cast<tag_t>(t.tag), [&](auto tag) {
+            for (std::size_t i = t.begin; i < t.end; ++i) {
+                auto &element = elements[indices[i]];
+                if constexpr (requires { visitor(tag, element.template get_ref<decltype(tag)::value>()); }) {
+                    visitor(tag, element.template get_ref<decltype(tag)::value>());
+                } else if constexpr (requires { visitor(element); }) {
+                    visitor(element);
+                } else {
+                    static_assert(detail::always_false_v<decltype(tag)>, "parallel_visit: the visitor accepts neither an alternative nor the union");
+                }
+            }
+        });
+    };
+    auto work = [&](std::size_t self) {
+        try {
+            std::size_t task;
+            while (!failed.load(std::memory_order_relaxed) && deques[self].pop_front(task)) {
+                run(tasks[task]);
+            }
+            for (std::size_t offset = 1; offset < workers && !failed.load(std::memory_order_relaxed); ++offset) {
+                while (!failed.load(std::memory_order_relaxed) && deques[(self + offset) % workers].steal_back(task)) {
+                    run(tasks[task]);
+                }
+            }
+        } catch (...) {
+            if (!failed.exchange(true)) {
+                error = std::current_exception();
+            }
+        }
+    };
+    {
+        // If starting a thread throws, the started workers stop after their current task and are joined on unwinding
+        std::vector<std::jthread> threads;
+        try {
+            threads.reserve(workers - 1);
+            for (std::size_t self = 1; self < workers; ++self) {
+                threads.emplace_back(work, self);
+            }
+        } catch (...) {
+            failed.store(true);
+            throw;
+        }
+        work(0);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+}
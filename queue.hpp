@@ -0,0 +1,268 @@
+#pragma once
+
+#include "tagged_union.hpp"
+
+#include <atomic>
+#include <optional>
+
+namespace tu {
+// Slot alignment that gives every queue slot its own cache line, so that a producer writing one slot and the consumer
+// reading its neighbour do not share a line
+inline constexpr std::size_t cache_line = 64;
+
+namespace detail {
+// Rounds the capacity of a ring up to a power of two, so that positions wrap with a mask
+constexpr std::size_t ring_capacity(std::size_t capacity) noexcept {
+    std::size_t power = 1;
+    while (power < capacity) {
+        power *= 2;
+    }
+    return power;
+}
+
+template<typename Union, std::size_t slot_align>
+struct alignas(std::max(slot_align, alignof(Union))) ring_slot {
+    Union *get() noexcept {
+        return std::launder(reinterpret_cast<Union *>(m_bytes));
+    }
+
+    alignas(Union) std::byte m_bytes[sizeof(Union)];
+};
+
+// Sequence numbers tell producers whether the slot is free and the consumer whether it has been filled
+template<typename Union, std::size_t slot_align>
+struct alignas(std::max(slot_align, alignof(Union))) sequenced_slot : ring_slot<Union, slot_align> {
+    std::atomic<std::size_t> m_sequence;
+    bool m_constructed;
+};
+}
+
+// Bounded single-producer single-consumer ring of unions. Messages are constructed in place in their slot with
+// try_emplace<tag>, and consumed in batches with try_pop_n, which visits each message in its slot and releases the
+// whole batch to the producer at once. Slots are aligned to slot_align, e.g. tu::cache_line.
+template<typename Union, std::size_t slot_align = alignof(Union)>
+struct spsc_ring {
+public:
+    using union_type = Union;
+    using tag_t = typename Union::tag_t;
+
+    // The capacity is rounded up to a power of two
+    explicit spsc_ring(std::size_t capacity)
+        : m_capacity(detail::ring_capacity(capacity)), m_slots(new slot_t[m_capacity]) {}
+
+    spsc_ring(spsc_ring const &) = delete;
+    spsc_ring &operator=(spsc_ring const &) = delete;
+
+    ~spsc_ring() {
+        for (std::size_t head = m_head.load(std::memory_order_relaxed), tail = m_tail.load(std::memory_order_relaxed); head != tail; ++head) {
+            std::destroy_at(slot(head).get());
+        }
+        delete[] m_slots;
+    }
+
+    std::size_t capacity() const noexcept {
+        return m_capacity;
+    }
+
+    // Producer: constructs the alternative tag from args in the next slot, or returns false if the ring is full
+    template<tag_t tag, typename... Args>
+    bool try_emplace(Args &&...args) {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cached_head == m_capacity) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if (tail - m_cached_head == m_capacity) {
+                return false;
+            }
+        }
+        std::construct_at(slot(tail).get(), tu::in_place_tag<tag>, std::forward<Args>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename U>
+        requires std::is_same_v<std::remove_cvref_t<U>, Union>
+    bool try_push(U &&value) {
+        return std::forward<U>(value).template visit_table<bool>([this](auto tag, auto &&alternative) {
+            return try_emplace<decltype(tag)::value>(std::forward<decltype(alternative)>(alternative));
+        });
+    }
+
+    // Consumer: removes the oldest message, or returns std::nullopt if the ring is empty
+    std::optional<Union> try_pop() {
+        std::optional<Union> value;
+        try_pop_n(1, [&](Union &&message) { value.emplace(std::move(message)); });
+        return value;
+    }
+
+    // Consumer: calls visitor(tu::in_place_tag<tag>, value) on up to max messages, in order, as visit_table would
+    // for an rvalue union, and returns the number of messages consumed
+    template<typename Visitor>
+    std::size_t try_pop_n(std::size_t max, Visitor &&visitor) {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (m_cached_tail - head < max) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+        }
+        std::size_t count = std::min(max, m_cached_tail - head);
+        std::size_t done = 0;
+        try {
+            for (; done < count; ++done) {
+                Union *message = slot(head + done).get();
+                std::move(*message).template visit_table<void>(visitor);
+                std::destroy_at(message);
+            }
+        } catch (...) {
+            std::destroy_at(slot(head + done).get());
+            m_head.store(head + done + 1, std::memory_order_release);
+            throw;
+        }
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    using slot_t = detail::ring_slot<Union, slot_align>;
+
+    slot_t &slot(std::size_t position) const noexcept {
+        return m_slots[position & (m_capacity - 1)];
+    }
+
+    std::size_t m_capacity;
+    slot_t *m_slots;
+    // Each side owns a cache line holding its position and its last view of the other side's position
+    alignas(cache_line) std::atomic<std::size_t> m_head{0};
+    std::size_t m_cached_tail = 0;
+    alignas(cache_line) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_cached_head = 0;
+};
+
+// Bounded multi-producer single-consumer queue of unions, with the same interface as spsc_ring. Producers claim a
+// slot with one CAS on the tail and construct the message in place, the consumer polls per-slot sequence numbers.
+template<typename Union, std::size_t slot_align = alignof(Union)>
+struct mpsc_queue {
+public:
+    using union_type = Union;
+    using tag_t = typename Union::tag_t;
+
+    // The capacity is rounded up to a power of two
+    explicit mpsc_queue(std::size_t capacity)
+        : m_capacity(detail::ring_capacity(capacity)), m_slots(new slot_t[m_capacity]) {
+        for (std::size_t i = 0; i < m_capacity; ++i) {
+            m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpsc_queue(mpsc_queue const &) = delete;
+    mpsc_queue &operator=(mpsc_queue const &) = delete;
+
+    ~mpsc_queue() {
+        for (std::size_t head = m_head;; ++head) {
+            slot_t &s = slot(head);
+            if (s.m_sequence.load(std::memory_order_acquire) != head + 1) {
+                break;
+            }
+            if (s.m_constructed) {
+                std::destroy_at(s.get());
+            }
+        }
+        delete[] m_slots;
+    }
+
+    std::size_t capacity() const noexcept {
+        return m_capacity;
+    }
+
+    // Producer: constructs the alternative tag from args in the next slot, or returns false if the queue is full
+    template<tag_t tag, typename... Args>
+    bool try_emplace(Args &&...args) {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        slot_t *s;
+        for (;;) {
+            s = &slot(tail);
+            std::size_t sequence = s->m_sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence - tail);
+            if (difference == 0) {
+                if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                tail = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+        // The slot is claimed, so it must be published even if the construction throws
+        try {
+            std::construct_at(s->get(), tu::in_place_tag<tag>, std::forward<Args>(args)...);
+            s->m_constructed = true;
+        } catch (...) {
+            s->m_constructed = false;
+            s->m_sequence.store(tail + 1, std::memory_order_release);
+            throw;
+        }
+        s->m_sequence.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename U>
+        requires std::is_same_v<std::remove_cvref_t<U>, Union>
+    bool try_push(U &&value) {
+        return std::forward<U>(value).template visit_table<bool>([this](auto tag, auto &&alternative) {
+            return try_emplace<decltype(tag)::value>(std::forward<decltype(alternative)>(alternative));
+        });
+    }
+
+    // Consumer: removes the oldest message, or returns std::nullopt if the queue is empty
+    std::optional<Union> try_pop() {
+        std::optional<Union> value;
+        try_pop_n(1, [&](Union &&message) { value.emplace(std::move(message)); });
+        return value;
+    }
+
+    // Consumer: calls visitor(tu::in_place_tag<tag>, value) on up to max messages, in order, as visit_table would
+    // for an rvalue union, and returns the number of messages consumed. Stops early at a slot that a producer has
+    // claimed but not yet filled.
+    template<typename Visitor>
+    std::size_t try_pop_n(std::size_t max, Visitor &&visitor) {
+        std::size_t count = 0;
+        while (count < max) {
+            slot_t &s = slot(m_head);
+            if (s.m_sequence.load(std::memory_order_acquire) != m_head + 1) {
+                break;
+            }
+            bool constructed = s.m_constructed;
+            std::size_t head = m_head++;
+            // Releases the slot to the producers also if the visitor throws
+            struct release {
+                slot_t &s;
+                std::size_t head;
+                std::size_t capacity;
+                bool constructed;
+
+                ~release() {
+                    if (constructed) {
+                        std::destroy_at(s.get());
+                    }
+                    s.m_sequence.store(head + capacity, std::memory_order_release);
+                }
+            } guard{s, head, m_capacity, constructed};
+            if (constructed) {
+                std::move(*s.get()).template visit_table<void>(visitor);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+private:
+    using slot_t = detail::sequenced_slot<Union, slot_align>;
+
+    slot_t &slot(std::size_t position) const noexcept {
+        return m_slots[position & (m_capacity - 1)];
+    }
+
+    std::size_t m_capacity;
+    slot_t *m_slots;
+    alignas(cache_line) std::size_t m_head = 0;
+    alignas(cache_line) std::atomic<std::size_t> m_tail{0};
+};
+}
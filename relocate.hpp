@@ -0,0 +1,408 @@
+#pragma once
+
+#include "tagged_union.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+
+namespace tu {
+// Whether a T can be relocated, i.e. move constructed into new storage with the source destroyed right after, by
+// copying its bytes (P1144 / P2786). True for trivially copyable types, std::unique_ptr with the default deleter,
+// std::shared_ptr, tu::boxed and tu::rec, and for unions whose stored alternatives all are. Specialize it as
+// std::true_type for other alternatives that hold no pointer into themselves, e.g. std::string on libc++ or std::vector
+// with std::allocator (but not std::string on libstdc++, which points into its own buffer).
+template<typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+template<typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template<typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template<typename T>
+struct is_trivially_relocatable<boxed<T>> : std::true_type {};
+
+template<typename T>
+struct is_trivially_relocatable<rec<T>> : std::true_type {};
+
+namespace detail {
+template<typename T>
+concept tagged_union = requires {
+    typename T::tag_t;
+    T::alternative_count;
+    typename T::template stored_t<static_cast<typename T::tag_t>(0)>;
+};
+
+template<typename Union, typename = std::make_index_sequence<Union::alternative_count>>
+struct alternatives_relocatable;
+
+template<typename Union, std::size_t... index>
+struct alternatives_relocatable<Union, std::index_sequence<index...>>
+    : std::bool_constant<(is_trivially_relocatable_v<typename Union::template stored_t<static_cast<typename Union::tag_t>(index)>> && ...)> {};
+}
+
+// A union only holds its tag and one of its stored alternatives, so it is relocatable when all of them are
+template<typename Union>
+    requires detail::tagged_union<Union>
+struct is_trivially_relocatable<Union> : std::bool_constant<std::is_trivially_copyable_v<Union> || detail::alternatives_relocatable<Union>::value> {};
+
+// Relocates [first, last) to the uninitialized storage at dest and returns the end of the destination: the objects exist
+// at dest afterwards and no longer in the source. Trivially relocatable types are copied with one memmove. Others are
+// move constructed and destroyed one by one if the move can't throw. Otherwise, as with std::move_if_noexcept, they are
+// all copied before the source is destroyed, so that a throwing copy leaves the source as it was; types that can only be
+// moved by a throwing move constructor are moved, and the source elements before the throw are left moved from. dest
+// may only overlap the source if dest <= first and T is trivially relocatable or nothrow move constructible.
+template<typename T>
+T *relocate(T *first, T *last, T *dest) noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (first != last) {
+            std::memmove(static_cast<void *>(dest), static_cast<void const *>(first), static_cast<std::size_t>(last - first) * sizeof(T));
+        }
+        return dest + (last - first);
+    } else if constexpr (std::is_nothrow_move_constructible_v<T>) {
+        for (; first != last; ++first, ++dest) {
+            std::construct_at(dest, std::move(*first));
+            std::destroy_at(first);
+        }
+        return dest;
+    } else {
+        T *end;
+        if constexpr (std::is_copy_constructible_v<T>) {
+            end = std::uninitialized_copy(first, last, dest);
+        } else {
+            end = std::uninitialized_move(first, last, dest);
+        }
+        std::destroy(first, last);
+        return end;
+    }
+}
+
+namespace detail {
+// Whether allocator_traits<Allocator>::construct and destroy fall back to std::construct_at and std::destroy_at, so that
+// elements may be relocated by copying their bytes (std::pmr::polymorphic_allocator, for one, constructs with
+// uses-allocator construction)
+template<typename Allocator, typename T>
+concept default_construct_destroy = !requires(Allocator &allocator, T *pointer) { allocator.construct(pointer, std::declval<T>()); }
+    && !requires(Allocator &allocator, T *pointer) { allocator.destroy(pointer); };
+}
+
+// Growable array that reallocates with tu::relocate, so that a vector of trivially relocatable unions moves all of its
+// elements with one memmove instead of a move constructor and destructor call, and a switch on the tag, per element.
+// Elements are constructed and destroyed through std::allocator_traits, and the memmove is only used if the allocator
+// leaves those to the defaults. The allocator propagates on copy assignment, move assignment and swap as its traits say.
+template<typename T, typename Allocator = std::allocator<T>>
+struct vector {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using iterator = T *;
+    using const_iterator = T const *;
+
+    vector() noexcept(noexcept(Allocator())) = default;
+
+    explicit vector(Allocator const &allocator) noexcept : m_allocator(allocator) {}
+
+    vector(vector const &other) : vector(other, traits::select_on_container_copy_construction(other.m_allocator)) {}
+
+    // Delegates so that the destructor frees the storage if an element copy throws
+    vector(vector const &other, Allocator const &allocator) : vector(allocator) {
+        reserve(other.size());
+        m_end = construct_range(other.m_begin, other.m_end, m_begin, [](T const &value) -> T const & { return value; });
+    }
+
+    vector(vector &&other) noexcept
+        : m_allocator(std::move(other.m_allocator)),
+          m_begin(std::exchange(other.m_begin, nullptr)),
+          m_end(std::exchange(other.m_end, nullptr)),
+          m_capacity(std::exchange(other.m_capacity, nullptr)) {}
+
+    vector &operator=(vector const &other) {
+        if (this != &other) {
+            // Copied into new storage first, so that a throwing copy leaves *this as it was
+            vector copy(other, traits::propagate_on_container_copy_assignment::value ? other.m_allocator : m_allocator);
+            destroy_storage();
+            if constexpr (traits::propagate_on_container_copy_assignment::value) {
+                m_allocator = other.m_allocator;
+            }
+            take_storage(copy);
+        }
+        return *this;
+    }
+
+    vector &operator=(vector &&other) noexcept(traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+        if constexpr (traits::propagate_on_container_move_assignment::value) {
+            destroy_storage();
+            m_allocator = std::move(other.m_allocator);
+            take_storage(other);
+        } else {
+            if (traits::is_always_equal::value || m_allocator == other.m_allocator) {
+                destroy_storage();
+                take_storage(other);
+            } else {
+                // Storage from another allocator can't be adopted, so the elements are moved one by one
+                vector moved(m_allocator);
+                moved.reserve(other.size());
+                moved.m_end = moved.construct_range(other.m_begin, other.m_end, moved.m_begin, [](T &value) -> T && { return std::move(value); });
+                destroy_storage();
+                take_storage(moved);
+            }
+        }
+        return *this;
+    }
+
+    ~vector() {
+        destroy_storage();
+    }
+
+    // Allocators that don't propagate on swap must be equal, as for the standard containers
+    void swap(vector &other) noexcept {
+        if constexpr (traits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(m_allocator, other.m_allocator);
+        } else {
+            assert(traits::is_always_equal::value || m_allocator == other.m_allocator);
+        }
+        std::swap(m_begin, other.m_begin);
+        std::swap(m_end, other.m_end);
+        std::swap(m_capacity, other.m_capacity);
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return m_allocator;
+    }
+
+    size_type size() const noexcept {
+        return static_cast<size_type>(m_end - m_begin);
+    }
+
+    size_type capacity() const noexcept {
+        return static_cast<size_type>(m_capacity - m_begin);
+    }
+
+    bool empty() const noexcept {
+        return m_begin == m_end;
+    }
+
+    T *data() noexcept {
+        return m_begin;
+    }
+
+    T const *data() const noexcept {
+        return m_begin;
+    }
+
+    iterator begin() noexcept {
+        return m_begin;
+    }
+
+    const_iterator begin() const noexcept {
+        return m_begin;
+    }
+
+    iterator end() noexcept {
+        return m_end;
+    }
+
+    const_iterator end() const noexcept {
+        return m_end;
+    }
+
+    T &operator[](size_type index) noexcept {
+        return m_begin[index];
+    }
+
+    T const &operator[](size_type index) const noexcept {
+        return m_begin[index];
+    }
+
+    T &front() noexcept {
+        return *m_begin;
+    }
+
+    T const &front() const noexcept {
+        return *m_begin;
+    }
+
+    T &back() noexcept {
+        return m_end[-1];
+    }
+
+    T const &back() const noexcept {
+        return m_end[-1];
+    }
+
+    void reserve(size_type count) {
+        if (count > capacity()) {
+            reallocate(count);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (m_capacity != m_end) {
+            reallocate(size());
+        }
+    }
+
+    template<typename... Args>
+    T &emplace_back(Args &&...args) {
+        if (m_end == m_capacity) {
+            // The new element is constructed before the old ones are relocated, as args may refer to them
+            size_type count = size();
+            size_type grown = std::max<size_type>(2 * count, 4);
+            T *storage = allocate(grown);
+            try {
+                traits::construct(m_allocator, storage + count, std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(storage, grown);
+                throw;
+            }
+            try {
+                relocate_elements(m_begin, m_end, storage);
+            } catch (...) {
+                traits::destroy(m_allocator, storage + count);
+                deallocate(storage, grown);
+                throw;
+            }
+            adopt(storage, grown);
+        } else {
+            traits::construct(m_allocator, m_end, std::forward<Args>(args)...);
+        }
+        return *m_end++;
+    }
+
+    void push_back(T const &value) {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept {
+        traits::destroy(m_allocator, --m_end);
+    }
+
+    // Removes the element at position, relocating the tail one slot down if T is trivially relocatable and move
+    // assigning it otherwise
+    iterator erase(const_iterator position) {
+        T *at = m_begin + (position - m_begin);
+        if constexpr (bitwise_relocatable) {
+            traits::destroy(m_allocator, at);
+            relocate(at + 1, m_end, at);
+            --m_end;
+        } else {
+            std::move(at + 1, m_end, at);
+            pop_back();
+        }
+        return at;
+    }
+
+    void clear() noexcept {
+        destroy_range(m_begin, m_end);
+        m_end = m_begin;
+    }
+
+private:
+    using traits = std::allocator_traits<Allocator>;
+
+    static constexpr bool bitwise_relocatable = is_trivially_relocatable_v<T> && detail::default_construct_destroy<Allocator, T>;
+
+    T *allocate(size_type count) {
+        return traits::allocate(m_allocator, count);
+    }
+
+    void deallocate(T *storage, size_type count) noexcept {
+        if (storage) {
+            traits::deallocate(m_allocator, storage, count);
+        }
+    }
+
+    void destroy_range(T *first, T *last) noexcept {
+        for (; first != last; ++first) {
+            traits::destroy(m_allocator, first);
+        }
+    }
+
+    // Destroys the elements and frees the storage, leaving the vector without either
+    void destroy_storage() noexcept {
+        clear();
+        deallocate(m_begin, capacity());
+        m_begin = m_end = m_capacity = nullptr;
+    }
+
+    // Takes the storage of other, which must have been allocated with an allocator equal to ours
+    void take_storage(vector &other) noexcept {
+        m_begin = std::exchange(other.m_begin, nullptr);
+        m_end = std::exchange(other.m_end, nullptr);
+        m_capacity = std::exchange(other.m_capacity, nullptr);
+    }
+
+    // Constructs cast(element) for each element of [first, last) at dest and returns the end, destroying the elements
+    // constructed so far if one of the constructors throws
+    template<typename Source, typename Cast>
+    T *construct_range(Source *first, Source *last, T *dest, Cast cast) {
+        T *at = dest;
+        try {
+            for (; first != last; ++first, ++at) {
+                traits::construct(m_allocator, at, cast(*first));
+            }
+        } catch (...) {
+            destroy_range(dest, at);
+            throw;
+        }
+        return at;
+    }
+
+    // tu::relocate through the allocator: the memmove if that is equivalent, element by element with
+    // std::move_if_noexcept semantics otherwise
+    T *relocate_elements(T *first, T *last, T *dest) {
+        if constexpr (bitwise_relocatable) {
+            return relocate(first, last, dest);
+        } else if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            for (; first != last; ++first, ++dest) {
+                traits::construct(m_allocator, dest, std::move(*first));
+                traits::destroy(m_allocator, first);
+            }
+            return dest;
+        } else {
+            T *end = construct_range(first, last, dest, [](T &value) -> decltype(auto) { return std::move_if_noexcept(value); });
+            destroy_range(first, last);
+            return end;
+        }
+    }
+
+    void reallocate(size_type count) {
+        T *storage = count ? allocate(count) : nullptr;
+        try {
+            relocate_elements(m_begin, m_end, storage);
+        } catch (...) {
+            deallocate(storage, count);
+            throw;
+        }
+        adopt(storage, count);
+    }
+
+    // Releases the current storage after its elements have been relocated to the front of storage
+    void adopt(T *storage, size_type count) noexcept {
+        size_type length = size();
+        deallocate(m_begin, capacity());
+        m_begin = storage;
+        m_end = storage + length;
+        m_capacity = storage + count;
+    }
+
+    [[no_unique_address]] Allocator m_allocator;
+    T *m_begin = nullptr;
+    T *m_end = nullptr;
+    T *m_capacity = nullptr;
+};
+}
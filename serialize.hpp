@@ -0,0 +1,307 @@
+#pragma once
+
+#include "tagged_union.hpp"
+
+#include <bit>
+#include <concepts>
+#include <new>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace tu {
+namespace detail {
+template<typename T>
+concept described_union = requires {
+    typename T::tag_t;
+    { T::layout_info() } -> std::same_as<layout_info>;
+};
+
+// Index of the only non-empty alternative of a union whose tag lives in the niches of that alternative
+template<typename Union>
+constexpr std::size_t niche_carrier_of() noexcept {
+    return []<std::size_t... i>(std::index_sequence<i...>) {
+        std::size_t carrier = 0;
+        ((carrier = std::is_empty_v<typename Union::template stored_t<typename Union::tag_t(i)>> ? carrier : i), ...);
+        return carrier;
+    }(std::make_index_sequence<Union::alternative_count>());
+}
+
+// Tag of the union whose object representation starts at bytes, or std::nullopt if it is out of range
+template<described_union Union>
+std::optional<typename Union::tag_t> representation_tag(std::byte const *bytes) noexcept {
+    using tag_t = typename Union::tag_t;
+    constexpr layout_info layout = Union::layout_info();
+    if constexpr (layout.tag_size != 0) {
+        std::underlying_type_t<tag_t> raw = 0;
+        std::memcpy(&raw, bytes + layout.tag_offset, std::min(layout.tag_size, sizeof(raw)));
+        if (raw >= Union::alternative_count) {
+            return std::nullopt;
+        }
+        return static_cast<tag_t>(raw);
+    } else {
+        constexpr std::size_t carrier = niche_carrier_of<Union>();
+        using niche_t = niche<typename Union::template stored_t<tag_t(carrier)>>;
+        if constexpr (niche_t::count == 0) {
+            return static_cast<tag_t>(carrier);
+        } else {
+            std::size_t index = niche_t::load(bytes + layout.storage_offset);
+            if (index == niche_t::count) {
+                return static_cast<tag_t>(carrier);
+            }
+            if (index >= Union::alternative_count - 1) {
+                return std::nullopt;
+            }
+            return static_cast<tag_t>(index < carrier ? index : index + 1);
+        }
+    }
+}
+
+// Whether bytes hold a valid object representation of the trivially copyable T: a bool is 0 or 1, and a union has a tag
+// in range and a valid active alternative. Other types, including enums with a fixed underlying type, accept any bytes.
+template<typename T>
+bool valid_representation(std::byte const *bytes) noexcept {
+    if constexpr (std::is_same_v<std::remove_cv_t<T>, bool>) {
+        return std::to_integer<unsigned char>(bytes[0]) < 2;
+    } else if constexpr (std::is_array_v<T>) {
+        for (std::size_t i = 0; i < std::extent_v<T>; ++i) {
+            if (!valid_representation<std::remove_extent_t<T>>(bytes + i * sizeof(std::remove_extent_t<T>))) {
+                return false;
+            }
+        }
+        return true;
+    } else if constexpr (described_union<T>) {
+        std::optional<typename T::tag_t> tag = representation_tag<T>(bytes);
+        return tag && dispatch_tag<T>(*tag, [&](auto tag) {
+            return valid_representation<typename T::template stored_t<decltype(tag)::value>>(bytes + T::layout_info().storage_offset);
+        });
+    } else {
+        return true;
+    }
+}
+}
+
+// Binary encoding of an alternative. Specializations provide:
+//   static constexpr bool trivial;                                    whether the encoding is the object representation
+//   static std::size_t size(T const &value) noexcept;                 number of bytes written by store
+//   static std::byte *store(T const &value, std::byte *out) noexcept; write value to out, returns the end of the written bytes
+//   static std::optional<T> load(std::span<std::byte const> &in);     read a value from the front of in and advance it,
+//                                                                     or std::nullopt if in is truncated or malformed
+// The primary template handles trivially copyable types with a single memcpy, and empty types with no bytes at all.
+// It rejects bytes that are not a valid object representation, such as a bool other than 0 or 1 or a nested union
+// with a tag out of range.
+template<typename T>
+struct serializer {
+    static_assert(std::is_trivially_copyable_v<T>, "specialize tu::serializer for alternatives that are not trivially copyable");
+
+    static constexpr bool trivial = true;
+    static constexpr std::size_t bytes = std::is_empty_v<T> ? 0 : sizeof(T);
+
+    static std::size_t size(T const &) noexcept {
+        return bytes;
+    }
+
+    static std::byte *store(T const &value, std::byte *out) noexcept {
+        std::memcpy(out, &value, bytes);
+        return out + bytes;
+    }
+
+    static std::optional<T> load(std::span<std::byte const> &in) noexcept {
+        if (in.size() < bytes || !detail::valid_representation<T>(in.data())) {
+            return std::nullopt;
+        }
+        std::array<std::byte, sizeof(T)> raw{};
+        std::memcpy(raw.data(), in.data(), bytes);
+        in = in.subspan(bytes);
+        return std::bit_cast<T>(raw);
+    }
+};
+
+// Length-prefixed sequences of trivially copyable elements
+template<typename Container, typename Element = typename Container::value_type>
+struct sequence_serializer {
+    static_assert(std::is_trivially_copyable_v<Element>);
+
+    static constexpr bool trivial = false;
+
+    static std::size_t size(Container const &value) noexcept {
+        return sizeof(std::uint64_t) + value.size() * sizeof(Element);
+    }
+
+    static std::byte *store(Container const &value, std::byte *out) noexcept {
+        std::uint64_t length = value.size();
+        std::memcpy(out, &length, sizeof(length));
+        if (length != 0) {
+            std::memcpy(out + sizeof(length), value.data(), length * sizeof(Element));
+        }
+        return out + size(value);
+    }
+
+    static std::optional<Container> load(std::span<std::byte const> &in) {
+        std::uint64_t length;
+        if (in.size() < sizeof(length)) {
+            return std::nullopt;
+        }
+        std::memcpy(&length, in.data(), sizeof(length));
+        if ((in.size() - sizeof(length)) / sizeof(Element) < length) {
+            return std::nullopt;
+        }
+        std::optional<Container> value(std::in_place, static_cast<std::size_t>(length), Element());
+        if (length != 0) {
+            std::memcpy(value->data(), in.data() + sizeof(length), length * sizeof(Element));
+        }
+        in = in.subspan(sizeof(length) + length * sizeof(Element));
+        return value;
+    }
+};
+
+template<typename Char, typename Traits, typename Allocator>
+struct serializer<std::basic_string<Char, Traits, Allocator>> : sequence_serializer<std::basic_string<Char, Traits, Allocator>> {};
+
+template<typename T, typename Allocator>
+struct serializer<std::vector<T, Allocator>> : sequence_serializer<std::vector<T, Allocator>> {};
+
+namespace detail {
+// Trivially encoded alternatives are padded to their alignment, so that a view into a buffer aligned to
+// alignof(Union) can point at them directly
+template<typename Union, typename Union::tag_t tag>
+inline constexpr std::size_t payload_offset = serializer<typename Union::template alternative_t<tag>>::trivial
+    ? (sizeof(tag) + alignof(typename Union::template alternative_t<tag>) - 1) / alignof(typename Union::template alternative_t<tag>) * alignof(typename Union::template alternative_t<tag>)
+    : sizeof(tag);
+
+template<typename Union>
+std::optional<typename Union::tag_t> load_tag(std::span<std::byte const> in) noexcept {
+    using tag_t = typename Union::tag_t;
+    std::underlying_type_t<tag_t> raw;
+    if (in.size() < sizeof(raw)) {
+        return std::nullopt;
+    }
+    std::memcpy(&raw, in.data(), sizeof(raw));
+    if (raw >= Union::alternative_count) {
+        return std::nullopt;
+    }
+    return static_cast<tag_t>(raw);
+}
+}
+
+// Number of bytes serialize writes for value
+template<typename Union>
+std::size_t serialized_size(Union const &value) noexcept {
+    return value.template visit_table<std::size_t>([](auto tag, auto const &alternative) {
+        using alternative_t = std::remove_cvref_t<decltype(alternative)>;
+        return detail::payload_offset<Union, decltype(tag)::value> + serializer<alternative_t>::size(alternative);
+    });
+}
+
+// Writes the tag followed by the alternative to the front of out, and returns the number of bytes written,
+// or 0 if out is too small
+template<typename Union>
+std::size_t serialize(Union const &value, std::span<std::byte> out) noexcept {
+    std::size_t size = serialized_size(value);
+    if (out.size() < size) {
+        return 0;
+    }
+    value.template visit_table<void>([&](auto tag, auto const &alternative) {
+        using alternative_t = std::remove_cvref_t<decltype(alternative)>;
+        auto raw = static_cast<std::underlying_type_t<typename Union::tag_t>>(decltype(tag)::value);
+        std::memcpy(out.data(), &raw, sizeof(raw));
+        std::memset(out.data() + sizeof(raw), 0, detail::payload_offset<Union, decltype(tag)::value> - sizeof(raw));
+        serializer<alternative_t>::store(alternative, out.data() + detail::payload_offset<Union, decltype(tag)::value>);
+    });
+    return size;
+}
+
+// Reads a union written by serialize from the front of in, or std::nullopt if in is truncated or malformed
+template<typename Union>
+std::optional<Union> deserialize(std::span<std::byte const> in) {
+    auto tag = detail::load_tag<Union>(in);
+    if (!tag) {
+        return std::nullopt;
+    }
+    return detail::dispatch_tag<Union>(*tag, [&](auto tag) -> std::optional<Union> {
+        constexpr std::size_t offset = detail::payload_offset<Union, decltype(tag)::value>;
+        if (in.size() < offset) {
+            return std::nullopt;
+        }
+        std::span<std::byte const> payload = in.subspan(offset);
+        auto alternative = serializer<typename Union::template alternative_t<decltype(tag)::value>>::load(payload);
+        if (!alternative) {
+            return std::nullopt;
+        }
+        return Union::template create<decltype(tag)::value>(std::move(*alternative));
+    });
+}
+
+// Read-only view of a union written by serialize, without constructing it. Trivially encoded alternatives are
+// accessed in place, which requires the buffer to be aligned to alignof(Union).
+template<typename Union>
+struct view : public Union::template named_accessors<view<Union>> {
+public:
+    using union_type = Union;
+    using tag_t = typename Union::tag_t;
+
+    template<tag_t tag>
+    using alternative_t = typename Union::template alternative_t<tag>;
+
+    explicit view(std::span<std::byte const> bytes) noexcept
+        : m_bytes(bytes) {}
+
+    // Whether the buffer holds a well-formed union, the other methods may only be called on valid views
+    bool valid() const {
+        auto tag = detail::load_tag<Union>(m_bytes);
+        return tag && detail::dispatch_tag<Union>(*tag, [&](auto tag) {
+            constexpr std::size_t offset = detail::payload_offset<Union, decltype(tag)::value>;
+            using serializer_t = serializer<alternative_t<decltype(tag)::value>>;
+            if constexpr (serializer_t::trivial) {
+                return m_bytes.size() >= offset + serializer_t::bytes && detail::valid_representation<alternative_t<decltype(tag)::value>>(m_bytes.data() + offset);
+            } else {
+                std::span<std::byte const> payload = m_bytes.subspan(std::min(offset, m_bytes.size()));
+                return m_bytes.size() >= offset && serializer_t::load(payload).has_value();
+            }
+        });
+    }
+
+    tag_t get_tag() const noexcept {
+        std::underlying_type_t<tag_t> raw;
+        std::memcpy(&raw, m_bytes.data(), sizeof(raw));
+        return static_cast<tag_t>(raw);
+    }
+
+    template<tag_t tag>
+    bool holds() const noexcept {
+        return get_tag() == tag;
+    }
+
+    template<tag_t tag>
+        requires serializer<alternative_t<tag>>::trivial
+    alternative_t<tag> const *get_ptr() const noexcept {
+        return holds<tag>() ? &get_ref<tag>() : nullptr;
+    }
+
+    template<tag_t tag>
+        requires serializer<alternative_t<tag>>::trivial
+    alternative_t<tag> const &get_ref() const noexcept {
+        if constexpr (std::is_empty_v<alternative_t<tag>>) {
+            static constexpr alternative_t<tag> empty{};
+            return empty;
+        } else {
+            std::byte const *payload = m_bytes.data() + detail::payload_offset<Union, tag>;
+            assert(reinterpret_cast<std::uintptr_t>(payload) % alignof(alternative_t<tag>) == 0 && "misaligned view");
+            return *std::launder(reinterpret_cast<alternative_t<tag> const *>(payload));
+        }
+    }
+
+    // Copy of the viewed union, also for alternatives that are not trivially encoded
+    Union load() const {
+        return *deserialize<Union>(m_bytes);
+    }
+
+    std::span<std::byte const> bytes() const noexcept {
+        return m_bytes;
+    }
+
+private:
+    std::span<std::byte const> m_bytes;
+};
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "tagged_union.hpp"
+
+#include <span>
+#include <vector>
+
+namespace tu {
+// Struct-of-arrays storage for a sequence of unions: a dense tag array plus one column per alternative,
+// so that tag-only queries read a single contiguous array and per-alternative loops read a single column
+template<typename Union>
+struct soa_vector : public Union::template named_push_back<soa_vector<Union>> {
+public:
+    using union_type = Union;
+    using tag_t = typename Union::tag_t;
+
+    template<tag_t tag>
+    using alternative_t = typename Union::template alternative_t<tag>;
+
+private:
+    template<typename Vector>
+    struct basic_reference : public Union::template named_accessors<basic_reference<Vector>> {
+    public:
+        basic_reference(Vector &vector, std::size_t index) noexcept
+            : m_vector(&vector), m_index(index) {}
+
+        tag_t get_tag() const noexcept {
+            return m_vector->m_tags[m_index];
+        }
+
+        template<tag_t tag>
+        bool holds() const noexcept {
+            return get_tag() == tag;
+        }
+
+        template<tag_t tag>
+        auto get_ptr() const noexcept {
+            return holds<tag>() ? &get_ref<tag>() : nullptr;
+        }
+
+        template<tag_t tag>
+        auto &get_ref() const noexcept {
+            return m_vector->template column<tag>()[m_vector->m_slots[m_index]];
+        }
+
+        // Copy of the element as a standalone union
+        Union load() const {
+            return m_vector->load(m_index);
+        }
+
+    private:
+        Vector *m_vector;
+        std::size_t m_index;
+    };
+
+public:
+    using reference = basic_reference<soa_vector>;
+    using const_reference = basic_reference<soa_vector const>;
+
+    std::size_t size() const noexcept {
+        return m_tags.size();
+    }
+
+    bool empty() const noexcept {
+        return m_tags.empty();
+    }
+
+    void reserve(std::size_t capacity) {
+        m_tags.reserve(capacity);
+        m_slots.reserve(capacity);
+    }
+
+    void clear() noexcept {
+        m_tags.clear();
+        m_slots.clear();
+        std::apply([](auto &...columns) { (columns.clear(), ...); }, m_columns);
+    }
+
+    template<tag_t tag, typename... Args>
+    alternative_t<tag> &emplace_back(Args &&...args) {
+        auto &column = std::get<static_cast<std::size_t>(tag)>(m_columns);
+        m_slots.push_back(column.size());
+        try {
+            auto &value = column.emplace_back(std::forward<Args>(args)...);
+            m_tags.push_back(tag);
+            return value;
+        } catch (...) {
+            if (column.size() > m_slots.back()) {
+                column.pop_back();
+            }
+            m_slots.pop_back();
+            throw;
+        }
+    }
+
+    template<typename U>
+        requires std::is_same_v<std::remove_cvref_t<U>, Union>
+    void push_back(U &&value) {
+        std::forward<U>(value).template visit_table<void>([this](auto tag, auto &&alternative) {
+            emplace_back<decltype(tag)::value>(std::forward<decltype(alternative)>(alternative));
+        });
+    }
+
+    // Elements are appended to the end of their column, so the last element is also the last of its column
+    void pop_back() {
+        static constexpr auto table = pop_table(std::make_index_sequence<Union::alternative_count>{});
+        table[static_cast<std::size_t>(m_tags.back())](*this);
+        m_tags.pop_back();
+        m_slots.pop_back();
+    }
+
+    reference operator[](std::size_t index) noexcept {
+        return reference(*this, index);
+    }
+
+    const_reference operator[](std::size_t index) const noexcept {
+        return const_reference(*this, index);
+    }
+
+    Union load(std::size_t index) const {
+        static constexpr auto table = load_table(std::make_index_sequence<Union::alternative_count>{});
+        return table[static_cast<std::size_t>(m_tags[index])](*this, m_slots[index]);
+    }
+
+    std::span<tag_t const> tags() const noexcept {
+        return m_tags;
+    }
+
+    template<tag_t tag>
+    std::span<alternative_t<tag>> column() noexcept {
+        return std::get<static_cast<std::size_t>(tag)>(m_columns);
+    }
+
+    template<tag_t tag>
+    std::span<alternative_t<tag> const> column() const noexcept {
+        return std::get<static_cast<std::size_t>(tag)>(m_columns);
+    }
+
+    // Number of elements holding tag, without scanning the tags
+    template<tag_t tag>
+    std::size_t count() const noexcept {
+        return std::get<static_cast<std::size_t>(tag)>(m_columns).size();
+    }
+
+    // Calls f on every element holding tag, in order, reading only that column
+    template<tag_t tag, typename F>
+    void for_each(F &&f) {
+        for (auto &value : column<tag>()) {
+            f(value);
+        }
+    }
+
+    template<tag_t tag, typename F>
+    void for_each(F &&f) const {
+        for (auto const &value : column<tag>()) {
+            f(value);
+        }
+    }
+
+private:
+    template<std::size_t... index>
+    static constexpr auto load_table(std::index_sequence<index...>) noexcept {
+        return std::array<Union (*)(soa_vector const &, std::size_t), Union::alternative_count>{
+            [](soa_vector const &self, std::size_t slot) {
+                constexpr auto tag = static_cast<tag_t>(index);
+                return Union::template create<tag>(self.template column<tag>()[slot]);
+            }...,
+        };
+    }
+
+    template<std::size_t... index>
+    static constexpr auto pop_table(std::index_sequence<index...>) noexcept {
+        return std::array<void (*)(soa_vector &), Union::alternative_count>{
+            [](soa_vector &self) { std::get<index>(self.m_columns).pop_back(); }...,
+        };
+    }
+
+    std::vector<tag_t> m_tags;
+    std::vector<std::size_t> m_slots;
+    typename detail::alternative_columns<Union, std::vector>::type m_columns;
+};
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "tagged_union.hpp"
+
+#include <bit>
+#include <span>
+
+#if defined(__AVX512BW__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace tu {
+namespace detail::simd {
+// match(p, value) compares `width` bytes starting at p with value and returns a bit mask of the equal bytes,
+// with `lane_bits` bits per byte of which only the lowest is kept by `lane_mask`
+#if defined(__AVX512BW__)
+inline constexpr std::size_t width = 64;
+inline constexpr std::size_t lane_bits = 1;
+inline constexpr std::uint64_t lane_mask = ~std::uint64_t(0);
+
+inline std::uint64_t match(unsigned char const *p, unsigned char value) noexcept {
+    return _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p), _mm512_set1_epi8(static_cast<char>(value)));
+}
+#elif defined(__AVX2__)
+inline constexpr std::size_t width = 32;
+inline constexpr std::size_t lane_bits = 1;
+inline constexpr std::uint64_t lane_mask = ~std::uint64_t(0);
+
+inline std::uint64_t match(unsigned char const *p, unsigned char value) noexcept {
+    __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(p)), _mm256_set1_epi8(static_cast<char>(value)));
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(eq));
+}
+#elif defined(__ARM_NEON)
+inline constexpr std::size_t width = 16;
+inline constexpr std::size_t lane_bits = 4;
+inline constexpr std::uint64_t lane_mask = 0x1111111111111111;
+
+inline std::uint64_t match(unsigned char const *p, unsigned char value) noexcept {
+    uint8x16_t eq = vceqq_u8(vld1q_u8(p), vdupq_n_u8(value));
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0) & lane_mask;
+}
+#else
+inline constexpr std::size_t width = 1;
+inline constexpr std::size_t lane_bits = 1;
+inline constexpr std::uint64_t lane_mask = 1;
+
+inline std::uint64_t match(unsigned char const *p, unsigned char value) noexcept {
+    return *p == value;
+}
+#endif
+
+// Calls f(i) for each set lane of mask, in ascending order
+template<typename F>
+void for_each_lane(std::uint64_t mask, std::size_t base, F &&f) {
+    for (; mask; mask &= mask - 1) {
+        f(base + static_cast<std::size_t>(std::countr_zero(mask)) / lane_bits);
+    }
+}
+
+template<typename Tag>
+unsigned char const *bytes(Tag const *tags) noexcept {
+    return reinterpret_cast<unsigned char const *>(tags);
+}
+}
+
+// Number of elements of tags equal to tag
+template<typename Tag>
+std::size_t count_tag(std::span<std::type_identity_t<Tag> const> tags, Tag tag) noexcept {
+    std::size_t count = 0;
+    std::size_t i = 0;
+    if constexpr (sizeof(Tag) == 1) {
+        auto const *p = detail::simd::bytes(tags.data());
+        for (; i + detail::simd::width <= tags.size(); i += detail::simd::width) {
+            count += static_cast<std::size_t>(std::popcount(detail::simd::match(p + i, static_cast<unsigned char>(tag))));
+        }
+    }
+    for (; i < tags.size(); ++i) {
+        count += tags[i] == tag;
+    }
+    return count;
+}
+
+// Index of the first element of tags equal to tag, or tags.size() if there is none
+template<auto tag>
+std::size_t find_first(std::span<decltype(tag) const> tags) noexcept {
+    std::size_t i = 0;
+    if constexpr (sizeof(tag) == 1) {
+        auto const *p = detail::simd::bytes(tags.data());
+        for (; i + detail::simd::width <= tags.size(); i += detail::simd::width) {
+            if (std::uint64_t mask = detail::simd::match(p + i, static_cast<unsigned char>(tag))) {
+                return i + static_cast<std::size_t>(std::countr_zero(mask)) / detail::simd::lane_bits;
+            }
+        }
+    }
+    for (; i < tags.size(); ++i) {
+        if (tags[i] == tag) {
+            return i;
+        }
+    }
+    return tags.size();
+}
+
+// Number of elements of tags holding each alternative of Union
+template<typename Union>
+std::array<std::size_t, Union::alternative_count> tag_histogram(std::span<typename Union::tag_t const> tags) noexcept {
+    using tag_t = typename Union::tag_t;
+    constexpr std::size_t bins = Union::alternative_count;
+    std::array<std::size_t, bins> counts{};
+    std::size_t i = 0;
+    if constexpr (sizeof(tag_t) == 1 && detail::simd::width > 1 && bins <= 16) {
+        // One compare per alternative per block is cheaper than a scattered increment per element
+        auto const *p = detail::simd::bytes(tags.data());
+        for (; i + detail::simd::width <= tags.size(); i += detail::simd::width) {
+            for (std::size_t bin = 0; bin < bins; ++bin) {
+                counts[bin] += static_cast<std::size_t>(std::popcount(detail::simd::match(p + i, static_cast<unsigned char>(bin))));
+            }
+        }
+    } else {
+        // Interleaved sub-histograms break the dependency between consecutive equal tags
+        std::array<std::array<std::size_t, bins>, 4> partial{};
+        for (; i + 4 <= tags.size(); i += 4) {
+            ++partial[0][static_cast<std::size_t>(tags[i + 0])];
+            ++partial[1][static_cast<std::size_t>(tags[i + 1])];
+            ++partial[2][static_cast<std::size_t>(tags[i + 2])];
+            ++partial[3][static_cast<std::size_t>(tags[i + 3])];
+        }
+        for (std::size_t bin = 0; bin < bins; ++bin) {
+            counts[bin] = partial[0][bin] + partial[1][bin] + partial[2][bin] + partial[3][bin];
+        }
+    }
+    for (; i < tags.size(); ++i) {
+        ++counts[static_cast<std::size_t>(tags[i])];
+    }
+    return counts;
+}
+
+// Writes the indices of the elements of tags equal to tag to the front of indices and the indices of the other
+// elements after them, both in ascending order, and returns the number of elements equal to tag.
+// indices must have room for tags.size() elements.
+template<typename Tag>
+std::size_t partition_by_tag(std::span<std::type_identity_t<Tag> const> tags, Tag tag, std::span<std::size_t> indices) noexcept {
+    assert(indices.size() >= tags.size());
+    std::size_t matched = count_tag(tags, tag);
+    std::size_t *front = indices.data();
+    std::size_t *back = indices.data() + matched;
+    std::size_t i = 0;
+    if constexpr (sizeof(Tag) == 1) {
+        auto const *p = detail::simd::bytes(tags.data());
+        constexpr std::uint64_t all = detail::simd::width * detail::simd::lane_bits == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << (detail::simd::width * detail::simd::lane_bits)) - 1;
+        for (; i + detail::simd::width <= tags.size(); i += detail::simd::width) {
+            std::uint64_t mask = detail::simd::match(p + i, static_cast<unsigned char>(tag));
+            detail::simd::for_each_lane(mask, i, [&](std::size_t index) { *front++ = index; });
+            detail::simd::for_each_lane(~mask & all & detail::simd::lane_mask, i, [&](std::size_t index) { *back++ = index; });
+        }
+    }
+    for (; i < tags.size(); ++i) {
+        *(tags[i] == tag ? front : back)++ = i;
+    }
+    return matched;
+}
+}
@@ -1,18 +1,332 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#if defined(TU_INSTRUMENT)
+#include <atomic>
+#include <mutex>
+#include <string>
+#endif
+
+#if defined(__GNUC__)
+#define TU_COLD [[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+#define TU_COLD [[msvc::noinline]]
+#else
+#define TU_COLD
+#endif
+
+// What the default label of every switch on the tag does, since a tag outside the alternatives can only come from
+// memory corruption or a bad cast: TU_INVALID_TAG_ASSERT asserts, TU_INVALID_TAG_TRAP traps (for hardened builds) and
+// TU_INVALID_TAG_UNREACHABLE tells the optimizer the default label can't be reached, so it omits the range check before
+// jump tables. Without any of them, debug builds assert and NDEBUG builds assume the tag is valid.
+#if !defined(TU_INVALID_TAG_ASSERT) && !defined(TU_INVALID_TAG_TRAP) && !defined(TU_INVALID_TAG_UNREACHABLE)
+#if defined(NDEBUG)
+#define TU_INVALID_TAG_UNREACHABLE
+#else
+#define TU_INVALID_TAG_ASSERT
+#endif
+#endif
+
+#if defined(TU_INVALID_TAG_TRAP)
+#if defined(__GNUC__)
+#define TU_INVALID_TAG() __builtin_trap()
+#else
+#define TU_INVALID_TAG() std::abort()
+#endif
+#elif defined(TU_INVALID_TAG_UNREACHABLE)
+#if defined(__cpp_lib_unreachable)
+#define TU_INVALID_TAG() std::unreachable()
+#elif defined(__GNUC__)
+#define TU_INVALID_TAG() __builtin_unreachable()
+#elif defined(_MSC_VER)
+#define TU_INVALID_TAG() __assume(false)
+#else
+#define TU_INVALID_TAG() std::abort()
+#endif
+#else
+#define TU_INVALID_TAG() assert(false && "bad tag")
+#endif
+
+#if defined(__cpp_explicit_this_parameter) && __cpp_explicit_this_parameter >= 202110L && !defined(TU_NO_DEDUCING_THIS)
+#define TU_DEDUCING_THIS
+#endif
 
 #define UNPACK(...) __VA_ARGS__
 
-#define VA_NARGS(...) VA_NARGS_IMPL(ignored, ##__VA_ARGS__, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
-#define VA_NARGS_IMPL(ignored, _9, _8, _7, _6, _5, _4, _3, _2, _1, N, ...) N
+#define VA_NARGS(...) VA_NARGS_IMPL(ignored, ##__VA_ARGS__, 256, 255, 254, 253, 252, 251, 250, 249, 248, 247, 246, 245, 244, 243, 242, 241, 240, 239, 238, 237, 236, 235, 234, 233, 232, 231, 230, 229, 228, 227, 226, 225, 224, 223, 222, 221, 220, 219, 218, 217, 216, 215, 214, 213, 212, 211, 210, 209, 208, 207, 206, 205, 204, 203, 202, 201, 200, 199, 198, 197, 196, 195, 194, 193, 192, 191, 190, 189, 188, 187, 186, 185, 184, 183, 182, 181, 180, 179, 178, 177, 176, 175, 174, 173, 172, 171, 170, 169, 168, 167, 166, 165, 164, 163, 162, 161, 160, 159, 158, 157, 156, 155, 154, 153, 152, 151, 150, 149, 148, 147, 146, 145, 144, 143, 142, 141, 140, 139, 138, 137, 136, 135, 134, 133, 132, 131, 130, 129, 128, 127, 126, 125, 124, 123, 122, 121, 120, 119, 118, 117, 116, 115, 114, 113, 112, 111, 110, 109, 108, 107, 106, 105, 104, 103, 102, 101, 100, 99, 98, 97, 96, 95, 94, 93, 92, 91, 90, 89, 88, 87, 86, 85, 84, 83, 82, 81, 80, 79, 78, 77, 76, 75, 74, 73, 72, 71, 70, 69, 68, 67, 66, 65, 64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define VA_NARGS_IMPL(ignored, _256, _255, _254, _253, _252, _251, _250, _249, _248, _247, _246, _245, _244, _243, _242, _241, _240, _239, _238, _237, _236, _235, _234, _233, _232, _231, _230, _229, _228, _227, _226, _225, _224, _223, _222, _221, _220, _219, _218, _217, _216, _215, _214, _213, _212, _211, _210, _209, _208, _207, _206, _205, _204, _203, _202, _201, _200, _199, _198, _197, _196, _195, _194, _193, _192, _191, _190, _189, _188, _187, _186, _185, _184, _183, _182, _181, _180, _179, _178, _177, _176, _175, _174, _173, _172, _171, _170, _169, _168, _167, _166, _165, _164, _163, _162, _161, _160, _159, _158, _157, _156, _155, _154, _153, _152, _151, _150, _149, _148, _147, _146, _145, _144, _143, _142, _141, _140, _139, _138, _137, _136, _135, _134, _133, _132, _131, _130, _129, _128, _127, _126, _125, _124, _123, _122, _121, _120, _119, _118, _117, _116, _115, _114, _113, _112, _111, _110, _109, _108, _107, _106, _105, _104, _103, _102, _101, _100, _99, _98, _97, _96, _95, _94, _93, _92, _91, _90, _89, _88, _87, _86, _85, _84, _83, _82, _81, _80, _79, _78, _77, _76, _75, _74, _73, _72, _71, _70, _69, _68, _67, _66, _65, _64, _63, _62, _61, _60, _59, _58, _57, _56, _55, _54, _53, _52, _51, _50, _49, _48, _47, _46, _45, _44, _43, _42, _41, _40, _39, _38, _37, _36, _35, _34, _33, _32, _31, _30, _29, _28, _27, _26, _25, _24, _23, _22, _21, _20, _19, _18, _17, _16, _15, _14, _13, _12, _11, _10, _9, _8, _7, _6, _5, _4, _3, _2, _1, N, ...) N
 
 #define CONCAT(a, b) CONCAT_IMPL(a, b)
 #define CONCAT_IMPL(a, b) a##b
 
 #define FOR_EACH(action, mems, ...) CONCAT(FOR_EACH_IMPL_, VA_NARGS(__VA_ARGS__))(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_256(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_240(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_255(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_239(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_254(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_238(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_253(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_237(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_252(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_236(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_251(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_235(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_250(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_234(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_249(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_233(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_248(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_232(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_247(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_231(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_246(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_230(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_245(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_229(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_244(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_228(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_243(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_227(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_242(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_226(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_241(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_225(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_240(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_224(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_239(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_223(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_238(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_222(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_237(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_221(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_236(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_220(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_235(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_219(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_234(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_218(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_233(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_217(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_232(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_216(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_231(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_215(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_230(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_214(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_229(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_213(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_228(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_212(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_227(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_211(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_226(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_210(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_225(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_209(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_224(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_208(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_223(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_207(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_222(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_206(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_221(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_205(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_220(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_204(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_219(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_203(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_218(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_202(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_217(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_201(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_216(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_200(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_215(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_199(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_214(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_198(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_213(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_197(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_212(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_196(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_211(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_195(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_210(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_194(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_209(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_193(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_208(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_192(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_207(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_191(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_206(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_190(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_205(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_189(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_204(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_188(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_203(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_187(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_202(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_186(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_201(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_185(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_200(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_184(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_199(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_183(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_198(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_182(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_197(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_181(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_196(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_180(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_195(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_179(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_194(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_178(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_193(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_177(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_192(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_176(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_191(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_175(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_190(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_174(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_189(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_173(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_188(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_172(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_187(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_171(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_186(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_170(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_185(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_169(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_184(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_168(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_183(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_167(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_182(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_166(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_181(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_165(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_180(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_164(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_179(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_163(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_178(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_162(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_177(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_161(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_176(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_160(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_175(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_159(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_174(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_158(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_173(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_157(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_172(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_156(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_171(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_155(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_170(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_154(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_169(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_153(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_168(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_152(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_167(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_151(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_166(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_150(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_165(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_149(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_164(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_148(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_163(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_147(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_162(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_146(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_161(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_145(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_160(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_144(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_159(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_143(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_158(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_142(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_157(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_141(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_156(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_140(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_155(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_139(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_154(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_138(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_153(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_137(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_152(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_136(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_151(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_135(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_150(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_134(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_149(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_133(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_148(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_132(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_147(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_131(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_146(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_130(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_145(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_129(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_144(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_128(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_143(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_127(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_142(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_126(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_141(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_125(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_140(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_124(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_139(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_123(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_138(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_122(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_137(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_121(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_136(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_120(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_135(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_119(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_134(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_118(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_133(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_117(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_132(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_116(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_131(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_115(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_130(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_114(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_129(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_113(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_128(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_112(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_127(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_111(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_126(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_110(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_125(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_109(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_124(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_108(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_123(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_107(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_122(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_106(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_121(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_105(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_120(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_104(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_119(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_103(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_118(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_102(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_117(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_101(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_116(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_100(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_115(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_99(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_114(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_98(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_113(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_97(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_112(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_96(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_111(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_95(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_110(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_94(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_109(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_93(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_108(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_92(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_107(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_91(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_106(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_90(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_105(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_89(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_104(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_88(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_103(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_87(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_102(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_86(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_101(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_85(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_100(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_84(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_99(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_83(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_98(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_82(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_97(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_81(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_96(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_80(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_95(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_79(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_94(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_78(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_93(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_77(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_92(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_76(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_91(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_75(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_90(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_74(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_89(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_73(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_88(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_72(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_87(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_71(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_86(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_70(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_85(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_69(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_84(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_68(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_83(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_67(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_82(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_66(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_81(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_65(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_80(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_64(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_79(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_63(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_78(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_62(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_77(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_61(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_76(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_60(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_75(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_59(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_74(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_58(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_73(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_57(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_72(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_56(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_71(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_55(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_70(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_54(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_69(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_53(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_68(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_52(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_67(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_51(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_66(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_50(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_65(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_49(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_64(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_48(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_63(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_47(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_62(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_46(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_61(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_45(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_60(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_44(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_59(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_43(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_58(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_42(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_57(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_41(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_56(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_40(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_55(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_39(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_54(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_38(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_53(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_37(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_52(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_36(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_51(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_35(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_50(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_34(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_49(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_33(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_48(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_32(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_47(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_31(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_46(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_30(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_45(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_29(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_44(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_28(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_43(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_27(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_42(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_26(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_41(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_25(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_40(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_24(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_39(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_23(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_38(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_22(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_37(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_21(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_36(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_20(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_35(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_19(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_34(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_18(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_33(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_17(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_32(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_16(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_31(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_15(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_30(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_14(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_29(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_13(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_28(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_12(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_27(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_11(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_26(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_10(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_25(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_9(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_24(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_8(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_23(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_7(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_22(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_6(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_21(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_5(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_20(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_4(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_19(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_3(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_18(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_2(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_17(action, mems, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, ...) action(mems, a1) action(mems, a2) action(mems, a3) action(mems, a4) action(mems, a5) action(mems, a6) action(mems, a7) action(mems, a8) action(mems, a9) action(mems, a10) action(mems, a11) action(mems, a12) action(mems, a13) action(mems, a14) action(mems, a15) action(mems, a16) FOR_EACH_IMPL_1(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_16(action, mems, args, ...) action(mems, args) FOR_EACH_IMPL_15(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_15(action, mems, args, ...) action(mems, args) FOR_EACH_IMPL_14(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_14(action, mems, args, ...) action(mems, args) FOR_EACH_IMPL_13(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_13(action, mems, args, ...) action(mems, args) FOR_EACH_IMPL_12(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_12(action, mems, args, ...) action(mems, args) FOR_EACH_IMPL_11(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_11(action, mems, args, ...) action(mems, args) FOR_EACH_IMPL_10(action, mems, __VA_ARGS__)
+#define FOR_EACH_IMPL_10(action, mems, args, ...) action(mems, args) FOR_EACH_IMPL_9(action, mems, __VA_ARGS__)
 #define FOR_EACH_IMPL_9(action, mems, args, ...) action(mems, args) FOR_EACH_IMPL_8(action, mems, __VA_ARGS__)
 #define FOR_EACH_IMPL_8(action, mems, args, ...) action(mems, args) FOR_EACH_IMPL_7(action, mems, __VA_ARGS__)
 #define FOR_EACH_IMPL_7(action, mems, args, ...) action(mems, args) FOR_EACH_IMPL_6(action, mems, __VA_ARGS__)
@@ -30,30 +344,81 @@
 #define UNION_TAG_FIELD_CALL(sums) UNION_TAG_FIELD_IMPL sums
 #define UNION_TAG_FIELD_IMPL(type_name, field_type, field_name) field_name,
 
+#define UNION_TAG_NAME(mems, args) UNION_TAG_NAME_CALL((UNPACK mems, UNPACK args))
+#define UNION_TAG_NAME_CALL(sums) UNION_TAG_NAME_IMPL sums
+#define UNION_TAG_NAME_IMPL(type_name, field_type, field_name) std::string_view(#field_name),
+
+#define UNION_FIELD_TYPE(mems, args) UNION_FIELD_TYPE_CALL((UNPACK mems, UNPACK args))
+#define UNION_FIELD_TYPE_CALL(sums) UNION_FIELD_TYPE_IMPL sums
+#define UNION_FIELD_TYPE_IMPL(type_name, field_type, field_name) std::string_view(#field_type),
+
+// alternative and member are partially specialized on an unused parameter, because explicit specializations at
+// class scope (CWG 727) are rejected by GCC
 #define UNION_ALTERNATIVE_TYPE(mems, args) UNION_ALTERNATIVE_TYPE_CALL((UNPACK mems, UNPACK args))
 #define UNION_ALTERNATIVE_TYPE_CALL(sums) UNION_ALTERNATIVE_TYPE_IMPL sums
 #define UNION_ALTERNATIVE_TYPE_IMPL(type_name, field_type, field_name) \
-    template<>                                                         \
-    struct alternative<tag_t::field_name> {                            \
-        using type = field_type;                                       \
+    template<typename Unused>                                          \
+    struct alternative<tag_t::field_name, Unused> {                    \
+        using stored = field_type;                                     \
+        using type = tu::detail::unboxed_t<stored>;                    \
     };
 
 #define UNION_STORAGE_FIELD(mems, args) UNION_STORAGE_FIELD_CALL((UNPACK mems, UNPACK args))
 #define UNION_STORAGE_FIELD_CALL(sums) UNION_STORAGE_FIELD_IMPL sums
-#define UNION_STORAGE_FIELD_IMPL(type_name, field_type, field_name) alternative_t<tag_t::field_name> field_name;
+#define UNION_STORAGE_FIELD_IMPL(type_name, field_type, field_name) stored_t<tag_t::field_name> field_name;
+
+#define UNION_ALL_OF(mems, args) UNION_ALL_OF_CALL((UNPACK mems, UNPACK args))
+#define UNION_ALL_OF_CALL(sums) UNION_ALL_OF_IMPL sums
+#define UNION_ALL_OF_IMPL(type_name, trait, field_type, field_name) trait<stored_t<tag_t::field_name>> &&
+
+
+#define UNION_ALTERNATIVE_SIZE(mems, args) UNION_ALTERNATIVE_SIZE_CALL((UNPACK mems, UNPACK args))
+#define UNION_ALTERNATIVE_SIZE_CALL(sums) UNION_ALTERNATIVE_SIZE_IMPL sums
+#define UNION_ALTERNATIVE_SIZE_IMPL(type_name, field_type, field_name) sizeof(stored_t<tag_t::field_name>),
+
+#define UNION_NICHE_INFO(mems, args) UNION_NICHE_INFO_CALL((UNPACK mems, UNPACK args))
+#define UNION_NICHE_INFO_CALL(sums) UNION_NICHE_INFO_IMPL sums
+#define UNION_NICHE_INFO_IMPL(type_name, field_type, field_name) {std::is_empty_v<stored_t<tag_t::field_name>>, tu::niche<stored_t<tag_t::field_name>>::count},
 
 #define UNION_COPY_CASE(mems, args) UNION_COPY_CASE_CALL((UNPACK mems, UNPACK args))
 #define UNION_COPY_CASE_CALL(sums) UNION_COPY_CASE_IMPL sums
-#define UNION_COPY_CASE_IMPL(type_name, field_type, field_name)                                                          \
-    case tag_t::field_name:                                                                                              \
-        new (std::addressof(this->m_storage.field_name)) alternative_t<tag_t::field_name>((other).m_storage.field_name); \
+#define UNION_COPY_CASE_IMPL(type_name, field_type, field_name)                                          \
+    case tag_t::field_name:                                                                              \
+        tu::detail::construct(std::addressof(this->m_storage.field_name), (other).m_storage.field_name); \
         break;
 
 #define UNION_MOVE_CASE(mems, args) UNION_MOVE_CASE_CALL((UNPACK mems, UNPACK args))
 #define UNION_MOVE_CASE_CALL(sums) UNION_MOVE_CASE_IMPL sums
-#define UNION_MOVE_CASE_IMPL(type_name, field_type, field_name)                                                                   \
-    case tag_t::field_name:                                                                                                       \
-        new (std::addressof(this->m_storage.field_name)) alternative_t<tag_t::field_name>(std::move(other).m_storage.field_name); \
+#define UNION_MOVE_CASE_IMPL(type_name, field_type, field_name)                                                   \
+    case tag_t::field_name:                                                                                       \
+        tu::detail::construct(std::addressof(this->m_storage.field_name), std::move(other).m_storage.field_name); \
+        break;
+
+#define UNION_ALLOCATOR_CONSTRUCT_CASE(mems, args) UNION_ALLOCATOR_CONSTRUCT_CASE_CALL((UNPACK mems, UNPACK args))
+#define UNION_ALLOCATOR_CONSTRUCT_CASE_CALL(sums) UNION_ALLOCATOR_CONSTRUCT_CASE_IMPL sums
+#define UNION_ALLOCATOR_CONSTRUCT_CASE_IMPL(type_name, source, field_type, field_name)                                                            \
+    case tag_t::field_name:                                                                                                                       \
+        tu::detail::store_using_allocator(std::addressof(this->m_storage.field_name), allocator, tu::detail::unbox(source.m_storage.field_name)); \
+        break;
+
+#define UNION_COPY_ASSIGN_CASE(mems, args) UNION_COPY_ASSIGN_CASE_CALL((UNPACK mems, UNPACK args))
+#define UNION_COPY_ASSIGN_CASE_CALL(sums) UNION_COPY_ASSIGN_CASE_IMPL sums
+#define UNION_COPY_ASSIGN_CASE_IMPL(type_name, field_type, field_name)          \
+    case tag_t::field_name:                                                     \
+        if constexpr (std::is_copy_assignable_v<stored_t<tag_t::field_name>>) { \
+            this->m_storage.field_name = (other).m_storage.field_name;          \
+            return *this;                                                       \
+        }                                                                       \
+        break;
+
+#define UNION_MOVE_ASSIGN_CASE(mems, args) UNION_MOVE_ASSIGN_CASE_CALL((UNPACK mems, UNPACK args))
+#define UNION_MOVE_ASSIGN_CASE_CALL(sums) UNION_MOVE_ASSIGN_CASE_IMPL sums
+#define UNION_MOVE_ASSIGN_CASE_IMPL(type_name, field_type, field_name)          \
+    case tag_t::field_name:                                                     \
+        if constexpr (std::is_move_assignable_v<stored_t<tag_t::field_name>>) { \
+            this->m_storage.field_name = std::move(other).m_storage.field_name; \
+            return *this;                                                       \
+        }                                                                       \
         break;
 
 #define UNION_DESTRUCT_CASE(mems, args) UNION_DESTRUCT_CASE_CALL((UNPACK mems, UNPACK args))
@@ -63,329 +428,812 @@
         std::destroy_at(std::addressof(this->m_storage.field_name)); \
         break;
 
-#define UNION_CONSTRUCT_IF_ELSE(mems, args) UNION_CONSTRUCT_IF_ELSE_CALL((UNPACK mems, UNPACK args))
-#define UNION_CONSTRUCT_IF_ELSE_CALL(sums) UNION_CONSTRUCT_IF_ELSE_IMPL sums
-#define UNION_CONSTRUCT_IF_ELSE_IMPL(type_name, field_type, field_name)                                                 \
-    if constexpr (tag == tag_t::field_name) {                                                                           \
-        new (std::addressof(this->m_storage.field_name)) alternative_t<tag_t::field_name>(std::forward<Args>(args)...); \
-    } else
-
-#define UNION_GET_PTR_IF_ELSE(mems, args) UNION_GET_PTR_IF_ELSE_CALL((UNPACK mems, UNPACK args))
-#define UNION_GET_PTR_IF_ELSE_CALL(sums) UNION_GET_PTR_IF_ELSE_IMPL sums
-#define UNION_GET_PTR_IF_ELSE_IMPL(type_name, field_type, field_name) \
-    if constexpr (tag == tag_t::field_name) {                         \
-        return m_tag == tag ? &this->m_storage.field_name : nullptr;  \
-    } else
-
-#define UNION_GET_LVALUE_REF_IF_ELSE(mems, args) UNION_GET_LVALUE_REF_IF_ELSE_CALL((UNPACK mems, UNPACK args))
-#define UNION_GET_LVALUE_REF_IF_ELSE_CALL(sums) UNION_GET_LVALUE_REF_IF_ELSE_IMPL sums
-#define UNION_GET_LVALUE_REF_IF_ELSE_IMPL(type_name, field_type, field_name) \
-    if constexpr (tag == tag_t::field_name) {                                \
-        return (*this).m_storage.field_name;                                 \
-    } else
-
-#define UNION_GET_RVALUE_REF_IF_ELSE(mems, args) UNION_GET_RVALUE_REF_IF_ELSE_CALL((UNPACK mems, UNPACK args))
-#define UNION_GET_RVALUE_REF_IF_ELSE_CALL(sums) UNION_GET_RVALUE_REF_IF_ELSE_IMPL sums
-#define UNION_GET_RVALUE_REF_IF_ELSE_IMPL(type_name, field_type, field_name) \
-    if constexpr (tag == tag_t::field_name) {                                \
-        return std::move(*this).m_storage.field_name;                        \
-    } else
-
-#define UNION_VISIT_LVALUE_REF_CASE(mems, args) UNION_VISIT_LVALUE_REF_CASE_CALL((UNPACK mems, UNPACK args))
-#define UNION_VISIT_LVALUE_REF_CASE_CALL(sums) UNION_VISIT_LVALUE_REF_CASE_IMPL sums
-#define UNION_VISIT_LVALUE_REF_CASE_IMPL(type_name, field_type, field_name)                                                              \
-    case tag_t::field_name:                                                                                                              \
-        if constexpr (requires { std::forward<Visitor>(visitor)(tu::in_place_tag<tag_t::field_name>, (*this).m_storage.field_name); }) { \
-            return std::forward<Visitor>(visitor)(tu::in_place_tag<tag_t::field_name>, (*this).m_storage.field_name);                    \
-        } else if constexpr (requires { std::forward<Visitor>(visitor)((*this)); }) {                                                    \
-            return std::forward<Visitor>(visitor)((*this));                                                                              \
-        } else {                                                                                                                         \
-            return;                                                                                                                      \
-        }
+#define UNION_MEMBER_POINTER(mems, args) UNION_MEMBER_POINTER_CALL((UNPACK mems, UNPACK args))
+#define UNION_MEMBER_POINTER_CALL(sums) UNION_MEMBER_POINTER_IMPL sums
+#define UNION_MEMBER_POINTER_IMPL(type_name, field_type, field_name) \
+    template<typename Unused>                                        \
+    struct member<tag_t::field_name, Unused> {                       \
+        static constexpr auto pointer = &storage_t::field_name;      \
+    };
 
-#define UNION_VISIT_RVALUE_REF_CASE(mems, args) UNION_VISIT_RVALUE_REF_CASE_CALL((UNPACK mems, UNPACK args))
-#define UNION_VISIT_RVALUE_REF_CASE_CALL(sums) UNION_VISIT_RVALUE_REF_CASE_IMPL sums
-#define UNION_VISIT_RVALUE_REF_CASE_IMPL(type_name, field_type, field_name)                                                                       \
-    case tag_t::field_name:                                                                                                                       \
-        if constexpr (requires { std::forward<Visitor>(visitor)(tu::in_place_tag<tag_t::field_name>, std::move(*this).m_storage.field_name); }) { \
-            return std::forward<Visitor>(visitor)(tu::in_place_tag<tag_t::field_name>, std::move(*this).m_storage.field_name);                    \
-        } else if constexpr (requires { std::forward<Visitor>(visitor)(std::move(*this)); }) {                                                    \
-            return std::forward<Visitor>(visitor)(std::move(*this));                                                                              \
-        } else {                                                                                                                                  \
-            return;                                                                                                                               \
+#define UNION_VISIT_CASE(mems, args) UNION_VISIT_CASE_CALL((UNPACK mems, UNPACK args))
+#define UNION_VISIT_CASE_CALL(sums) UNION_VISIT_CASE_IMPL sums
+#define UNION_VISIT_CASE_IMPL(type_name, self, field_type, field_name)                                                                                                 \
+    case tag_t::field_name:                                                                                                                                            \
+        if constexpr (tu::detail::is_cold<type_name, Visitor>(tag_t::field_name)) {                                                                                    \
+            return tu::detail::cold_call<ReturnType>([&]() -> ReturnType { return visit_arm<tag_t::field_name, ReturnType>(self, std::forward<Visitor>(visitor)); });  \
+        } else if constexpr (requires { std::forward<Visitor>(visitor)(tu::in_place_tag<tag_t::field_name>, tu::detail::unbox(self.m_data.m_storage.field_name)); }) { \
+            return std::forward<Visitor>(visitor)(tu::in_place_tag<tag_t::field_name>, tu::detail::unbox(self.m_data.m_storage.field_name));                           \
+        } else if constexpr (requires { std::forward<Visitor>(visitor)(self); }) {                                                                                     \
+            return std::forward<Visitor>(visitor)(self);                                                                                                               \
+        } else {                                                                                                                                                       \
+            static_assert(tu::detail::always_false_v<Visitor>, "visit: the visitor accepts neither the alternative " #field_name " nor the union");                    \
         }
 
+#define UNION_VISIT_TABLE_ENTRY(mems, args) UNION_VISIT_TABLE_ENTRY_CALL((UNPACK mems, UNPACK args))
+#define UNION_VISIT_TABLE_ENTRY_CALL(sums) UNION_VISIT_TABLE_ENTRY_IMPL sums
+#define UNION_VISIT_TABLE_ENTRY_IMPL(type_name, field_type, field_name) &type_name::visit_arm<tag_t::field_name, ReturnType, Self, Visitor>,
+
+#define UNION_PROFILED_CHECK(type_name, check, arm, self, Functor, functor)           \
+    if constexpr (tu::detail::profile_checks<type_name, Functor>() > check) {         \
+        constexpr tag_t hot = tu::detail::profile_check_v<type_name, check, Functor>; \
+        if ((self).m_data.tag() == hot) [[likely]] {                                  \
+            return arm<hot, ReturnType>(self, std::forward<Functor>(functor));        \
+        }                                                                             \
+    }
+
+#define UNION_PROFILED_CHECKS(type_name, arm, self, Functor, functor) \
+    UNION_PROFILED_CHECK(type_name, 0, arm, self, Functor, functor)   \
+    UNION_PROFILED_CHECK(type_name, 1, arm, self, Functor, functor)   \
+    UNION_PROFILED_CHECK(type_name, 2, arm, self, Functor, functor)   \
+    UNION_PROFILED_CHECK(type_name, 3, arm, self, Functor, functor)
+
+#define UNION_MATCH_ARM(mems, args) UNION_MATCH_ARM_CALL((UNPACK mems, UNPACK args))
+#define UNION_MATCH_ARM_CALL(sums) UNION_MATCH_ARM_IMPL sums
+#define UNION_MATCH_ARM_IMPL(type_name, field_type, field_name)                                                                           \
+    if constexpr (tag == tag_t::field_name) {                                                                                             \
+        if constexpr (requires { std::forward<Matcher>(matcher).case_##field_name(std::forward<Self>(self).template get_ref<tag>()); }) { \
+            return std::forward<Matcher>(matcher).case_##field_name(std::forward<Self>(self).template get_ref<tag>());                    \
+        } else if constexpr (requires { std::forward<Matcher>(matcher).otherwise(std::forward<Self>(self)); }) {                          \
+            return std::forward<Matcher>(matcher).otherwise(std::forward<Self>(self));                                                    \
+        } else {                                                                                                                          \
+            static_assert(tu::detail::always_false_v<Matcher>, "match: the matcher has neither case_" #field_name " nor otherwise");      \
+        }                                                                                                                                 \
+    }
+
 #define UNION_SPECIFIC_METHOD(mems, args) UNION_SPECIFIC_METHOD_CALL((UNPACK mems, UNPACK args))
 #define UNION_SPECIFIC_METHOD_CALL(sums) UNION_SPECIFIC_METHOD_IMPL sums
-#define UNION_SPECIFIC_METHOD_IMPL(type_name, field_type, field_name)            \
-    template<typename... Args>                                                   \
-    static type_name create_##field_name(Args &&...args) {                       \
-        return create<tag_t::field_name>(std::forward<Args>(args)...);           \
-    }                                                                            \
-                                                                                 \
-    template<typename... Args>                                                   \
-    alternative_t<tag_t::field_name> &emplace_##field_name(Args &&...args) {     \
-        return emplace<tag_t::field_name>(std::forward<Args>(args)...);          \
-    }                                                                            \
-                                                                                 \
-    alternative_t<tag_t::field_name> *get_##field_name##_ptr() {                 \
-        return this->get_ptr<tag_t::field_name>();                               \
-    }                                                                            \
-                                                                                 \
-    alternative_t<tag_t::field_name> const *get_##field_name##_ptr() const {     \
-        return this->get_ptr<tag_t::field_name>();                               \
-    }                                                                            \
-                                                                                 \
-    alternative_t<tag_t::field_name> &get_##field_name##_ref() & {               \
-        return (*this).template get_ref<tag_t::field_name>();                    \
-    }                                                                            \
-                                                                                 \
-    alternative_t<tag_t::field_name> const &get_##field_name##_ref() const & {   \
-        return (*this).template get_ref<tag_t::field_name>();                    \
-    }                                                                            \
-                                                                                 \
-    alternative_t<tag_t::field_name> &&get_##field_name##_ref() && {             \
-        return std::move(*this).template get_ref<tag_t::field_name>();           \
-    }                                                                            \
-                                                                                 \
-    alternative_t<tag_t::field_name> const &&get_##field_name##_ref() const && { \
-        return std::move(*this).template get_ref<tag_t::field_name>();           \
-    }                                                                            \
-                                                                                 \
-    bool holds_##field_name() const {                                            \
-        return holds<tag_t::field_name>();                                       \
-    }
-
-#define UNION_MATCH_LVALUE_REF_CASE(mems, args) UNION_MATCH_LVALUE_REF_CASE_CALL((UNPACK mems, UNPACK args))
-#define UNION_MATCH_LVALUE_REF_CASE_CALL(sums) UNION_MATCH_LVALUE_REF_CASE_IMPL sums
-#define UNION_MATCH_LVALUE_REF_CASE_IMPL(type_name, field_type, field_name)                                           \
-    case tag_t::field_name:                                                                                           \
-        if constexpr (requires { std::forward<Matcher>(matcher).case_##field_name((*this).m_storage.field_name); }) { \
-            return std::forward<Matcher>(matcher).case_##field_name((*this).m_storage.field_name);                    \
-        } else if constexpr (requires { std::forward<Matcher>(matcher).otherwise((*this)); }) {                       \
-            return std::forward<Matcher>(matcher).otherwise((*this));                                                 \
-        } else {                                                                                                      \
-            return;                                                                                                   \
-        }
+#define UNION_SPECIFIC_METHOD_IMPL(type_name, field_type, field_name)                          \
+    template<typename... Args>                                                                 \
+    static constexpr type_name create_##field_name(Args &&...args)                             \
+        noexcept(tu::detail::is_nothrow_storable_v<stored_t<tag_t::field_name>, Args...>) {    \
+        return create<tag_t::field_name>(std::forward<Args>(args)...);                         \
+    }                                                                                          \
+                                                                                               \
+    template<typename... Args>                                                                 \
+    constexpr alternative_t<tag_t::field_name> &emplace_##field_name(Args &&...args)           \
+        noexcept(tu::detail::is_nothrow_emplaceable_v<stored_t<tag_t::field_name>, Args...>) { \
+        return emplace<tag_t::field_name>(std::forward<Args>(args)...);                        \
+    }                                                                                          \
+                                                                                               \
+    constexpr alternative_t<tag_t::field_name> *get_##field_name##_ptr() {                     \
+        return this->get_ptr<tag_t::field_name>();                                             \
+    }                                                                                          \
+                                                                                               \
+    constexpr alternative_t<tag_t::field_name> const *get_##field_name##_ptr() const {         \
+        return this->get_ptr<tag_t::field_name>();                                             \
+    }                                                                                          \
+                                                                                               \
+    UNION_SPECIFIC_REF_METHODS(type_name, field_name)                                          \
+                                                                                               \
+    constexpr bool holds_##field_name() const {                                                \
+        return holds<tag_t::field_name>();                                                     \
+    }
 
-#define UNION_MATCH_RVALUE_REF_CASE(mems, args) UNION_MATCH_RVALUE_REF_CASE_CALL((UNPACK mems, UNPACK args))
-#define UNION_MATCH_RVALUE_REF_CASE_CALL(sums) UNION_MATCH_RVALUE_REF_CASE_IMPL sums
-#define UNION_MATCH_RVALUE_REF_CASE_IMPL(type_name, field_type, field_name)                                                    \
-    case tag_t::field_name:                                                                                                    \
-        if constexpr (requires { std::forward<Matcher>(matcher).case_##field_name(std::move(*this).m_storage.field_name); }) { \
-            return std::forward<Matcher>(matcher).case_##field_name(std::move(*this).m_storage.field_name);                    \
-        } else if constexpr (requires { std::forward<Matcher>(matcher).otherwise(std::move(*this)); }) {                       \
-            return std::forward<Matcher>(matcher).otherwise(std::move(*this));                                                 \
-        } else {                                                                                                               \
-            return;                                                                                                            \
+#define UNION_MATCH_CASE(mems, args) UNION_MATCH_CASE_CALL((UNPACK mems, UNPACK args))
+#define UNION_MATCH_CASE_CALL(sums) UNION_MATCH_CASE_IMPL sums
+#define UNION_MATCH_CASE_IMPL(type_name, self, field_type, field_name)                                                                                                \
+    case tag_t::field_name:                                                                                                                                           \
+        if constexpr (tu::detail::is_cold<type_name, Matcher>(tag_t::field_name)) {                                                                                   \
+            return tu::detail::cold_call<ReturnType>([&]() -> ReturnType { return match_arm<tag_t::field_name, ReturnType>(self, std::forward<Matcher>(matcher)); }); \
+        } else if constexpr (requires { std::forward<Matcher>(matcher).case_##field_name(tu::detail::unbox(self.m_data.m_storage.field_name)); }) {                   \
+            return std::forward<Matcher>(matcher).case_##field_name(tu::detail::unbox(self.m_data.m_storage.field_name));                                             \
+        } else if constexpr (requires { std::forward<Matcher>(matcher).otherwise(self); }) {                                                                          \
+            return std::forward<Matcher>(matcher).otherwise(self);                                                                                                    \
+        } else {                                                                                                                                                      \
+            static_assert(tu::detail::always_false_v<Matcher>, "match: the matcher has neither case_" #field_name " nor otherwise");                                  \
         }
 
-#define UNION(type_name, ...)                                                         \
-    struct type_name {                                                                \
-        enum class tag_t {                                                            \
-            FOR_EACH(UNION_TAG_FIELD, (type_name), __VA_ARGS__)                       \
-        };                                                                            \
-                                                                                      \
-        template<tag_t tag>                                                           \
-        struct alternative;                                                           \
-        FOR_EACH(UNION_ALTERNATIVE_TYPE, (type_name), __VA_ARGS__)                    \
-                                                                                      \
-        template<tag_t tag>                                                           \
-        using alternative_t = typename alternative<tag>::type;                        \
-                                                                                      \
-        union storage_t {                                                             \
-            storage_t() {}                                                            \
-            ~storage_t() {}                                                           \
-            FOR_EACH(UNION_STORAGE_FIELD, (type_name), __VA_ARGS__)                   \
-        };                                                                            \
-                                                                                      \
-        type_name(type_name const &other) : m_tag(other.m_tag) {                      \
-            switch (m_tag) {                                                          \
-                FOR_EACH(UNION_COPY_CASE, (type_name), __VA_ARGS__)                   \
-            default:                                                                  \
-                assert(false && "bad tag");                                           \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        type_name(type_name &&other) : m_tag(other.m_tag) {                           \
-            switch (m_tag) {                                                          \
-                FOR_EACH(UNION_MOVE_CASE, (type_name), __VA_ARGS__)                   \
-            default:                                                                  \
-                assert(false && "bad tag");                                           \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        ~type_name() {                                                                \
-            switch (m_tag) {                                                          \
-                FOR_EACH(UNION_DESTRUCT_CASE, (type_name), __VA_ARGS__)               \
-            default:                                                                  \
-                assert(false && "bad tag");                                           \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        type_name &operator=(type_name const &other) {                                \
-            if (this != &other) {                                                     \
-                this->~type_name();                                                   \
-                new (this) type_name((other));                                        \
-            }                                                                         \
-            return *this;                                                             \
-        }                                                                             \
-                                                                                      \
-        type_name &operator=(type_name &&other) {                                     \
-            if (this != &other) {                                                     \
-                this->~type_name();                                                   \
-                new (this) type_name(std::move(other));                               \
-            }                                                                         \
-            return *this;                                                             \
-        }                                                                             \
-                                                                                      \
-        template<tag_t tag, typename... Args>                                         \
-        type_name(tu::in_place_tag_t<tag>, Args &&...args) : m_tag(tag) {             \
-            FOR_EACH(UNION_CONSTRUCT_IF_ELSE, (type_name), __VA_ARGS__) {             \
-                assert(false && "bad tag");                                           \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        template<tag_t tag, typename... Args>                                         \
-        static type_name create(Args &&...args) {                                     \
-            return type_name(tu::in_place_tag<tag>, std::forward<Args>(args)...);     \
-        }                                                                             \
-                                                                                      \
-        template<tag_t tag, typename... Args>                                         \
-        alternative_t<tag> &emplace(Args &&...args) {                                 \
-            this->~type_name();                                                       \
-            new (this) type_name(tu::in_place_tag<tag>, std::forward<Args>(args)...); \
-            return get_ref<tag>();                                                    \
-        }                                                                             \
-                                                                                      \
-        template<tag_t tag>                                                           \
-        alternative_t<tag> *get_ptr() {                                               \
-            FOR_EACH(UNION_GET_PTR_IF_ELSE, (type_name), __VA_ARGS__) {               \
-                static_assert(false, "bad tag");                                      \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        template<tag_t tag>                                                           \
-        alternative_t<tag> const *get_ptr() const {                                   \
-            FOR_EACH(UNION_GET_PTR_IF_ELSE, (type_name), __VA_ARGS__) {               \
-                static_assert(false, "bad tag");                                      \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        template<tag_t tag>                                                           \
-        alternative_t<tag> &get_ref() & {                                             \
-            FOR_EACH(UNION_GET_LVALUE_REF_IF_ELSE, (type_name), __VA_ARGS__) {        \
-                static_assert(false, "bad tag");                                      \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        template<tag_t tag>                                                           \
-        alternative_t<tag> const &get_ref() const & {                                 \
-            FOR_EACH(UNION_GET_LVALUE_REF_IF_ELSE, (type_name), __VA_ARGS__) {        \
-                static_assert(false, "bad tag");                                      \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        template<tag_t tag>                                                           \
-        alternative_t<tag> &&get_ref() && {                                           \
-            FOR_EACH(UNION_GET_RVALUE_REF_IF_ELSE, (type_name), __VA_ARGS__) {        \
-                static_assert(false, "bad tag");                                      \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        template<tag_t tag>                                                           \
-        alternative_t<tag> const &&get_ref() const && {                               \
-            FOR_EACH(UNION_GET_RVALUE_REF_IF_ELSE, (type_name), __VA_ARGS__) {        \
-                static_assert(false, "bad tag");                                      \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        tag_t get_tag() const {                                                       \
-            return m_tag;                                                             \
-        }                                                                             \
-                                                                                      \
-        template<tag_t tag>                                                           \
-        bool holds() const {                                                          \
-            return m_tag == tag;                                                      \
-        }                                                                             \
-                                                                                      \
-        template<typename ReturnType, typename Visitor>                               \
-        ReturnType visit(Visitor &&visitor) & {                                       \
-            switch (m_tag) {                                                          \
-                FOR_EACH(UNION_VISIT_LVALUE_REF_CASE, (type_name), __VA_ARGS__)       \
-            default:                                                                  \
-                assert(false && "bad tag");                                           \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        template<typename ReturnType, typename Visitor>                               \
-        ReturnType visit(Visitor &&visitor) const & {                                 \
-            switch (m_tag) {                                                          \
-                FOR_EACH(UNION_VISIT_LVALUE_REF_CASE, (type_name), __VA_ARGS__)       \
-            default:                                                                  \
-                assert(false && "bad tag");                                           \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        template<typename ReturnType, typename Visitor>                               \
-        ReturnType visit(Visitor &&visitor) && {                                      \
-            switch (m_tag) {                                                          \
-                FOR_EACH(UNION_VISIT_RVALUE_REF_CASE, (type_name), __VA_ARGS__)       \
-            default:                                                                  \
-                assert(false && "bad tag");                                           \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        template<typename ReturnType, typename Visitor>                               \
-        ReturnType visit(Visitor &&visitor) const && {                                \
-            switch (m_tag) {                                                          \
-                FOR_EACH(UNION_VISIT_RVALUE_REF_CASE, (type_name), __VA_ARGS__)       \
-            default:                                                                  \
-                assert(false && "bad tag");                                           \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        FOR_EACH(UNION_SPECIFIC_METHOD, (type_name), __VA_ARGS__)                     \
-                                                                                      \
-        template<typename ReturnType, typename Matcher>                               \
-        ReturnType match(Matcher &&matcher) & {                                       \
-            switch (m_tag) {                                                          \
-                FOR_EACH(UNION_MATCH_LVALUE_REF_CASE, (type_name), __VA_ARGS__)       \
-            default:                                                                  \
-                assert(false && "bad tag");                                           \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        template<typename ReturnType, typename Matcher>                               \
-        ReturnType match(Matcher &&matcher) const & {                                 \
-            switch (m_tag) {                                                          \
-                FOR_EACH(UNION_MATCH_LVALUE_REF_CASE, (type_name), __VA_ARGS__)       \
-            default:                                                                  \
-                assert(false && "bad tag");                                           \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        template<typename ReturnType, typename Matcher>                               \
-        ReturnType match(Matcher &&matcher) && {                                      \
-            switch (m_tag) {                                                          \
-                FOR_EACH(UNION_MATCH_RVALUE_REF_CASE, (type_name), __VA_ARGS__)       \
-            default:                                                                  \
-                assert(false && "bad tag");                                           \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-        template<typename ReturnType, typename Matcher>                               \
-        ReturnType match(Matcher &&matcher) const && {                                \
-            switch (m_tag) {                                                          \
-                FOR_EACH(UNION_MATCH_RVALUE_REF_CASE, (type_name), __VA_ARGS__)       \
-            default:                                                                  \
-                assert(false && "bad tag");                                           \
-            }                                                                         \
-        }                                                                             \
-                                                                                      \
-    private:                                                                          \
-        tag_t m_tag;                                                                  \
-        storage_t m_storage;                                                          \
+#define UNION_EQUAL_CASE(mems, args) UNION_EQUAL_CASE_CALL((UNPACK mems, UNPACK args))
+#define UNION_EQUAL_CASE_CALL(sums) UNION_EQUAL_CASE_IMPL sums
+#define UNION_EQUAL_CASE_IMPL(type_name, field_type, field_name) \
+    case tag_t::field_name:                                      \
+        return tu::detail::equal(tu::detail::unbox(self.m_data.m_storage.field_name), tu::detail::unbox(other.m_data.m_storage.field_name));
+
+#define UNION_COMPARE_CASE(mems, args) UNION_COMPARE_CASE_CALL((UNPACK mems, UNPACK args))
+#define UNION_COMPARE_CASE_CALL(sums) UNION_COMPARE_CASE_IMPL sums
+#define UNION_COMPARE_CASE_IMPL(type_name, field_type, field_name) \
+    case tag_t::field_name:                                        \
+        return tu::detail::compare(tu::detail::unbox(self.m_data.m_storage.field_name), tu::detail::unbox(other.m_data.m_storage.field_name));
+
+#define UNION_HASH_CASE(mems, args) UNION_HASH_CASE_CALL((UNPACK mems, UNPACK args))
+#define UNION_HASH_CASE_CALL(sums) UNION_HASH_CASE_IMPL sums
+#define UNION_HASH_CASE_IMPL(type_name, field_type, field_name) \
+    case tag_t::field_name:                                     \
+        return tu::detail::hash_combine(static_cast<std::size_t>(tag_t::field_name), tu::detail::hash(tu::detail::unbox(self.m_data.m_storage.field_name)));
+
+
+#define UNION_TRAITS(type_name, ...)                                                                                                                       \
+    static constexpr bool trivially_destructible = (FOR_EACH(UNION_ALL_OF, (type_name, std::is_trivially_destructible_v), __VA_ARGS__) true);              \
+    static constexpr bool trivially_copy_constructible = (FOR_EACH(UNION_ALL_OF, (type_name, std::is_trivially_copy_constructible_v), __VA_ARGS__) true);  \
+    static constexpr bool trivially_move_constructible = (FOR_EACH(UNION_ALL_OF, (type_name, std::is_trivially_move_constructible_v), __VA_ARGS__) true);  \
+    static constexpr bool trivially_copy_assignable = (FOR_EACH(UNION_ALL_OF, (type_name, tu::detail::is_trivially_copy_assignable_v), __VA_ARGS__) true); \
+    static constexpr bool trivially_move_assignable = (FOR_EACH(UNION_ALL_OF, (type_name, tu::detail::is_trivially_move_assignable_v), __VA_ARGS__) true); \
+    static constexpr bool copy_constructible = (FOR_EACH(UNION_ALL_OF, (type_name, std::is_copy_constructible_v), __VA_ARGS__) true);                      \
+    static constexpr bool move_constructible = (FOR_EACH(UNION_ALL_OF, (type_name, std::is_move_constructible_v), __VA_ARGS__) true);                      \
+    static constexpr bool nothrow_copy_constructible = (FOR_EACH(UNION_ALL_OF, (type_name, std::is_nothrow_copy_constructible_v), __VA_ARGS__) true);      \
+    static constexpr bool nothrow_move_constructible = (FOR_EACH(UNION_ALL_OF, (type_name, std::is_nothrow_move_constructible_v), __VA_ARGS__) true);      \
+    static constexpr bool nothrow_copy_assignable = (FOR_EACH(UNION_ALL_OF, (type_name, tu::detail::is_nothrow_copy_assignable_v), __VA_ARGS__) true);     \
+    static constexpr bool nothrow_move_assignable = (FOR_EACH(UNION_ALL_OF, (type_name, tu::detail::is_nothrow_move_assignable_v), __VA_ARGS__) true);     \
+    static constexpr std::size_t niche_carrier = tu::detail::find_niche_carrier({FOR_EACH(UNION_NICHE_INFO, (type_name), __VA_ARGS__)});                   \
+    static constexpr std::size_t niche_carrier_or_zero = niche_carrier != SIZE_MAX ? niche_carrier : 0;
+
+#define BOXED(...) tu::boxed<__VA_ARGS__>
+
+#if defined(TU_INSTRUMENT)
+#define UNION_RECORD_VISIT(type_name, tag) tu::detail::instrumentation<type_name>::record_visit(tag)
+#define UNION_RECORD_TRANSITION(type_name, from, to) tu::detail::instrumentation<type_name>::record_transition(from, to)
+#define UNION_STATS(type_name)                                     \
+    static tu::union_stats<alternative_count> stats() {            \
+        return tu::detail::instrumentation<type_name>::snapshot(); \
+    }
+#else
+#define UNION_RECORD_VISIT(type_name, tag)
+#define UNION_RECORD_TRANSITION(type_name, from, to)
+#define UNION_STATS(type_name)
+#endif
+
+#define UNION(type_name, ...) UNION_WITH_LAYOUT(type_name, tu::layout::tag_first, __VA_ARGS__)
+
+#define UNION_NAMED_ACCESSOR(mems, args) UNION_NAMED_ACCESSOR_CALL((UNPACK mems, UNPACK args))
+#define UNION_NAMED_ACCESSOR_CALL(sums) UNION_NAMED_ACCESSOR_IMPL sums
+#define UNION_NAMED_ACCESSOR_IMPL(type_name, field_type, field_name)                      \
+    constexpr auto get_##field_name##_ptr() const {                                       \
+        return static_cast<Derived const &>(*this).template get_ptr<tag_t::field_name>(); \
+    }                                                                                     \
+                                                                                          \
+    constexpr decltype(auto) get_##field_name##_ref() const {                             \
+        return static_cast<Derived const &>(*this).template get_ref<tag_t::field_name>(); \
+    }                                                                                     \
+                                                                                          \
+    constexpr bool holds_##field_name() const {                                           \
+        return static_cast<Derived const &>(*this).template holds<tag_t::field_name>();   \
+    }
+
+#define UNION_NAMED_PUSH_BACK(mems, args) UNION_NAMED_PUSH_BACK_CALL((UNPACK mems, UNPACK args))
+#define UNION_NAMED_PUSH_BACK_CALL(sums) UNION_NAMED_PUSH_BACK_IMPL sums
+#define UNION_NAMED_PUSH_BACK_IMPL(type_name, field_type, field_name)                                               \
+    template<typename... Args>                                                                                      \
+    constexpr decltype(auto) push_back_##field_name(Args &&...args) {                                               \
+        return static_cast<Derived &>(*this).template emplace_back<tag_t::field_name>(std::forward<Args>(args)...); \
+    }
+
+#if defined(TU_DEDUCING_THIS)
+// One explicit object member function template per method instead of four ref-qualified overloads. self_t is the
+// union with the value category and constness of the object expression, also when it is called on a derived class.
+
+#define UNION_GET_REF_METHODS(type_name)                                                                                             \
+template<tag_t tag, typename Self>                                                                                                   \
+constexpr tu::detail::forward_like_t<Self, alternative_t<tag>> get_ref(this Self &&self) {                                           \
+    return tu::detail::unbox(static_cast<tu::detail::forward_like_t<Self, type_name>>(self).m_data.m_storage.*member<tag>::pointer); \
+}
+
+#define UNION_VISIT_METHODS(type_name, ...)                                                                                              \
+template<typename ReturnType, typename Self, typename Visitor>                                                                           \
+constexpr ReturnType visit(this Self &&self, Visitor &&visitor) {                                                                        \
+    using self_t = tu::detail::forward_like_t<Self, type_name>;                                                                          \
+    UNION_RECORD_VISIT(type_name, static_cast<self_t>(self).m_data.tag());                                                               \
+    UNION_PROFILED_CHECKS(type_name, visit_arm, static_cast<self_t>(self), Visitor, visitor)                                             \
+    switch (static_cast<self_t>(self).m_data.tag()) {                                                                                    \
+        FOR_EACH(UNION_VISIT_CASE, (type_name, static_cast<self_t>(self)), __VA_ARGS__)                                                  \
+    default:                                                                                                                             \
+        TU_INVALID_TAG();                                                                                                                \
+    }                                                                                                                                    \
+}                                                                                                                                        \
+                                                                                                                                         \
+template<typename ReturnType, typename Self, typename Visitor>                                                                           \
+constexpr ReturnType visit_table(this Self &&self, Visitor &&visitor) {                                                                  \
+    return visit_table_impl<ReturnType>(static_cast<tu::detail::forward_like_t<Self, type_name>>(self), std::forward<Visitor>(visitor)); \
+}                                                                                                                                        \
+                                                                                                                                         \
+template<tag_t tag, typename ReturnType, typename Self, typename Visitor>                                                                \
+constexpr ReturnType visit_expect(this Self &&self, Visitor &&visitor) {                                                                 \
+    using self_t = tu::detail::forward_like_t<Self, type_name>;                                                                          \
+    if (static_cast<self_t>(self).m_data.tag() == tag) [[likely]] {                                                                      \
+        UNION_RECORD_VISIT(type_name, tag);                                                                                              \
+        return visit_arm<tag, ReturnType>(static_cast<self_t>(self), std::forward<Visitor>(visitor));                                    \
+    }                                                                                                                                    \
+    return static_cast<self_t>(self).template visit<ReturnType>(std::forward<Visitor>(visitor));                                         \
+}
+
+#define UNION_MATCH_METHODS(type_name, ...)                                                  \
+template<typename ReturnType, typename Self, typename Matcher>                               \
+constexpr ReturnType match(this Self &&self, Matcher &&matcher) {                            \
+    using self_t = tu::detail::forward_like_t<Self, type_name>;                              \
+    UNION_RECORD_VISIT(type_name, static_cast<self_t>(self).m_data.tag());                   \
+    UNION_PROFILED_CHECKS(type_name, match_arm, static_cast<self_t>(self), Matcher, matcher) \
+    switch (static_cast<self_t>(self).m_data.tag()) {                                        \
+        FOR_EACH(UNION_MATCH_CASE, (type_name, static_cast<self_t>(self)), __VA_ARGS__)      \
+    default:                                                                                 \
+        TU_INVALID_TAG();                                                                    \
+    }                                                                                        \
+}
+
+#define UNION_SPECIFIC_REF_METHODS(type_name, field_name)                                                               \
+template<typename Self>                                                                                                 \
+constexpr tu::detail::forward_like_t<Self, alternative_t<tag_t::field_name>> get_##field_name##_ref(this Self &&self) { \
+    return static_cast<tu::detail::forward_like_t<Self, type_name>>(self).template get_ref<tag_t::field_name>();        \
+}
+#else
+// Four overloads per method, for the value categories and constness of the object expression
+#define UNION_GET_REF_METHODS(type_name)                                               \
+template<tag_t tag>                                                                    \
+constexpr alternative_t<tag> &get_ref() & {                                            \
+    return tu::detail::unbox((*this).m_data.m_storage.*member<tag>::pointer);          \
+}                                                                                      \
+                                                                                       \
+template<tag_t tag>                                                                    \
+constexpr alternative_t<tag> const &get_ref() const & {                                \
+    return tu::detail::unbox((*this).m_data.m_storage.*member<tag>::pointer);          \
+}                                                                                      \
+                                                                                       \
+template<tag_t tag>                                                                    \
+constexpr alternative_t<tag> &&get_ref() && {                                          \
+    return tu::detail::unbox(std::move(*this).m_data.m_storage.*member<tag>::pointer); \
+}                                                                                      \
+                                                                                       \
+template<tag_t tag>                                                                    \
+constexpr alternative_t<tag> const &&get_ref() const && {                              \
+    return tu::detail::unbox(std::move(*this).m_data.m_storage.*member<tag>::pointer); \
+}
+
+#define UNION_VISIT_METHODS(type_name, ...)                                                  \
+template<typename ReturnType, typename Visitor>                                              \
+constexpr ReturnType visit(Visitor &&visitor) & {                                            \
+    UNION_RECORD_VISIT(type_name, m_data.tag());                                             \
+    UNION_PROFILED_CHECKS(type_name, visit_arm, *this, Visitor, visitor)                     \
+    switch (m_data.tag()) {                                                                  \
+        FOR_EACH(UNION_VISIT_CASE, (type_name, (*this)), __VA_ARGS__)                        \
+    default:                                                                                 \
+        TU_INVALID_TAG();                                                                    \
+    }                                                                                        \
+}                                                                                            \
+                                                                                             \
+template<typename ReturnType, typename Visitor>                                              \
+constexpr ReturnType visit(Visitor &&visitor) const & {                                      \
+    UNION_RECORD_VISIT(type_name, m_data.tag());                                             \
+    UNION_PROFILED_CHECKS(type_name, visit_arm, *this, Visitor, visitor)                     \
+    switch (m_data.tag()) {                                                                  \
+        FOR_EACH(UNION_VISIT_CASE, (type_name, (*this)), __VA_ARGS__)                        \
+    default:                                                                                 \
+        TU_INVALID_TAG();                                                                    \
+    }                                                                                        \
+}                                                                                            \
+                                                                                             \
+template<typename ReturnType, typename Visitor>                                              \
+constexpr ReturnType visit(Visitor &&visitor) && {                                           \
+    UNION_RECORD_VISIT(type_name, m_data.tag());                                             \
+    UNION_PROFILED_CHECKS(type_name, visit_arm, std::move(*this), Visitor, visitor)          \
+    switch (m_data.tag()) {                                                                  \
+        FOR_EACH(UNION_VISIT_CASE, (type_name, std::move(*this)), __VA_ARGS__)               \
+    default:                                                                                 \
+        TU_INVALID_TAG();                                                                    \
+    }                                                                                        \
+}                                                                                            \
+                                                                                             \
+template<typename ReturnType, typename Visitor>                                              \
+constexpr ReturnType visit(Visitor &&visitor) const && {                                     \
+    UNION_RECORD_VISIT(type_name, m_data.tag());                                             \
+    UNION_PROFILED_CHECKS(type_name, visit_arm, std::move(*this), Visitor, visitor)          \
+    switch (m_data.tag()) {                                                                  \
+        FOR_EACH(UNION_VISIT_CASE, (type_name, std::move(*this)), __VA_ARGS__)               \
+    default:                                                                                 \
+        TU_INVALID_TAG();                                                                    \
+    }                                                                                        \
+}                                                                                            \
+                                                                                             \
+template<typename ReturnType, typename Visitor>                                              \
+constexpr ReturnType visit_table(Visitor &&visitor) & {                                      \
+    return visit_table_impl<ReturnType>(*this, std::forward<Visitor>(visitor));              \
+}                                                                                            \
+                                                                                             \
+template<typename ReturnType, typename Visitor>                                              \
+constexpr ReturnType visit_table(Visitor &&visitor) const & {                                \
+    return visit_table_impl<ReturnType>(*this, std::forward<Visitor>(visitor));              \
+}                                                                                            \
+                                                                                             \
+template<typename ReturnType, typename Visitor>                                              \
+constexpr ReturnType visit_table(Visitor &&visitor) && {                                     \
+    return visit_table_impl<ReturnType>(std::move(*this), std::forward<Visitor>(visitor));   \
+}                                                                                            \
+                                                                                             \
+template<typename ReturnType, typename Visitor>                                              \
+constexpr ReturnType visit_table(Visitor &&visitor) const && {                               \
+    return visit_table_impl<ReturnType>(std::move(*this), std::forward<Visitor>(visitor));   \
+}                                                                                            \
+                                                                                             \
+template<tag_t tag, typename ReturnType, typename Visitor>                                   \
+constexpr ReturnType visit_expect(Visitor &&visitor) & {                                     \
+    if (m_data.tag() == tag) [[likely]] {                                                    \
+        UNION_RECORD_VISIT(type_name, tag);                                                  \
+        return visit_arm<tag, ReturnType>(*this, std::forward<Visitor>(visitor));            \
+    }                                                                                        \
+    return (*this).template visit<ReturnType>(std::forward<Visitor>(visitor));               \
+}                                                                                            \
+                                                                                             \
+template<tag_t tag, typename ReturnType, typename Visitor>                                   \
+constexpr ReturnType visit_expect(Visitor &&visitor) const & {                               \
+    if (m_data.tag() == tag) [[likely]] {                                                    \
+        UNION_RECORD_VISIT(type_name, tag);                                                  \
+        return visit_arm<tag, ReturnType>(*this, std::forward<Visitor>(visitor));            \
+    }                                                                                        \
+    return (*this).template visit<ReturnType>(std::forward<Visitor>(visitor));               \
+}                                                                                            \
+                                                                                             \
+template<tag_t tag, typename ReturnType, typename Visitor>                                   \
+constexpr ReturnType visit_expect(Visitor &&visitor) && {                                    \
+    if (m_data.tag() == tag) [[likely]] {                                                    \
+        UNION_RECORD_VISIT(type_name, tag);                                                  \
+        return visit_arm<tag, ReturnType>(std::move(*this), std::forward<Visitor>(visitor)); \
+    }                                                                                        \
+    return (std::move(*this)).template visit<ReturnType>(std::forward<Visitor>(visitor));    \
+}                                                                                            \
+                                                                                             \
+template<tag_t tag, typename ReturnType, typename Visitor>                                   \
+constexpr ReturnType visit_expect(Visitor &&visitor) const && {                              \
+    if (m_data.tag() == tag) [[likely]] {                                                    \
+        UNION_RECORD_VISIT(type_name, tag);                                                  \
+        return visit_arm<tag, ReturnType>(std::move(*this), std::forward<Visitor>(visitor)); \
+    }                                                                                        \
+    return (std::move(*this)).template visit<ReturnType>(std::forward<Visitor>(visitor));    \
+}
+
+#define UNION_MATCH_METHODS(type_name, ...)                                         \
+template<typename ReturnType, typename Matcher>                                     \
+constexpr ReturnType match(Matcher &&matcher) & {                                   \
+    UNION_RECORD_VISIT(type_name, m_data.tag());                                    \
+    UNION_PROFILED_CHECKS(type_name, match_arm, *this, Matcher, matcher)            \
+    switch (m_data.tag()) {                                                         \
+        FOR_EACH(UNION_MATCH_CASE, (type_name, (*this)), __VA_ARGS__)               \
+    default:                                                                        \
+        TU_INVALID_TAG();                                                           \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+template<typename ReturnType, typename Matcher>                                     \
+constexpr ReturnType match(Matcher &&matcher) const & {                             \
+    UNION_RECORD_VISIT(type_name, m_data.tag());                                    \
+    UNION_PROFILED_CHECKS(type_name, match_arm, *this, Matcher, matcher)            \
+    switch (m_data.tag()) {                                                         \
+        FOR_EACH(UNION_MATCH_CASE, (type_name, (*this)), __VA_ARGS__)               \
+    default:                                                                        \
+        TU_INVALID_TAG();                                                           \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+template<typename ReturnType, typename Matcher>                                     \
+constexpr ReturnType match(Matcher &&matcher) && {                                  \
+    UNION_RECORD_VISIT(type_name, m_data.tag());                                    \
+    UNION_PROFILED_CHECKS(type_name, match_arm, std::move(*this), Matcher, matcher) \
+    switch (m_data.tag()) {                                                         \
+        FOR_EACH(UNION_MATCH_CASE, (type_name, std::move(*this)), __VA_ARGS__)      \
+    default:                                                                        \
+        TU_INVALID_TAG();                                                           \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+template<typename ReturnType, typename Matcher>                                     \
+constexpr ReturnType match(Matcher &&matcher) const && {                            \
+    UNION_RECORD_VISIT(type_name, m_data.tag());                                    \
+    UNION_PROFILED_CHECKS(type_name, match_arm, std::move(*this), Matcher, matcher) \
+    switch (m_data.tag()) {                                                         \
+        FOR_EACH(UNION_MATCH_CASE, (type_name, std::move(*this)), __VA_ARGS__)      \
+    default:                                                                        \
+        TU_INVALID_TAG();                                                           \
+    }                                                                               \
+}
+
+#define UNION_SPECIFIC_REF_METHODS(type_name, field_name)                              \
+constexpr alternative_t<tag_t::field_name> &get_##field_name##_ref() & {               \
+    return (*this).template get_ref<tag_t::field_name>();                              \
+}                                                                                      \
+                                                                                       \
+constexpr alternative_t<tag_t::field_name> const &get_##field_name##_ref() const & {   \
+    return (*this).template get_ref<tag_t::field_name>();                              \
+}                                                                                      \
+                                                                                       \
+constexpr alternative_t<tag_t::field_name> &&get_##field_name##_ref() && {             \
+    return std::move(*this).template get_ref<tag_t::field_name>();                     \
+}                                                                                      \
+                                                                                       \
+constexpr alternative_t<tag_t::field_name> const &&get_##field_name##_ref() const && { \
+    return std::move(*this).template get_ref<tag_t::field_name>();                     \
+}
+#endif
+
+#define UNION_WITH_LAYOUT(type_name, layout_policy, ...)                                                                                                                                              \
+    struct type_name {                                                                                                                                                                                \
+        enum class tag_t : tu::detail::smallest_unsigned_t<VA_NARGS(__VA_ARGS__)> {                                                                                                                   \
+            FOR_EACH(UNION_TAG_FIELD, (type_name), __VA_ARGS__)                                                                                                                                       \
+        };                                                                                                                                                                                            \
+                                                                                                                                                                                                      \
+        static constexpr std::size_t alternative_count = VA_NARGS(__VA_ARGS__);                                                                                                                       \
+                                                                                                                                                                                                      \
+        static constexpr std::size_t tag_count = alternative_count;                                                                                                                                   \
+                                                                                                                                                                                                      \
+        static constexpr std::string_view union_name = #type_name;                                                                                                                                    \
+                                                                                                                                                                                                      \
+        static constexpr std::array<std::string_view, alternative_count> tag_names = {FOR_EACH(UNION_TAG_NAME, (type_name), __VA_ARGS__)};                                                            \
+                                                                                                                                                                                                      \
+        static constexpr std::array<std::string_view, alternative_count> field_types = {FOR_EACH(UNION_FIELD_TYPE, (type_name), __VA_ARGS__)};                                                        \
+                                                                                                                                                                                                      \
+        template<tag_t tag, typename = void>                                                                                                                                                          \
+        struct alternative;                                                                                                                                                                           \
+        FOR_EACH(UNION_ALTERNATIVE_TYPE, (type_name), __VA_ARGS__)                                                                                                                                    \
+                                                                                                                                                                                                      \
+        template<tag_t tag>                                                                                                                                                                           \
+        using alternative_t = typename alternative<tag>::type;                                                                                                                                        \
+                                                                                                                                                                                                      \
+        template<tag_t tag>                                                                                                                                                                           \
+        using stored_t = typename alternative<tag>::stored;                                                                                                                                           \
+                                                                                                                                                                                                      \
+        static constexpr std::array<std::size_t, alternative_count> alternative_sizes = {FOR_EACH(UNION_ALTERNATIVE_SIZE, (type_name), __VA_ARGS__)};                                                 \
+                                                                                                                                                                                                      \
+        template<tag_t tag, typename... Args>                                                                                                                                                         \
+        constexpr type_name(tu::in_place_tag_t<tag> in_place, Args &&...args)                                                                                                                         \
+            noexcept(tu::detail::is_nothrow_storable_v<stored_t<tag>, Args...>)                                                                                                                       \
+            : m_data(in_place, std::forward<Args>(args)...) {}                                                                                                                                        \
+                                                                                                                                                                                                      \
+        template<typename Allocator, tag_t tag, typename... Args>                                                                                                                                     \
+        constexpr type_name(std::allocator_arg_t, Allocator const &allocator, tu::in_place_tag_t<tag> in_place, Args &&...args)                                                                       \
+            : m_data(std::allocator_arg, allocator, in_place, std::forward<Args>(args)...) {}                                                                                                         \
+                                                                                                                                                                                                      \
+        template<tag_t tag, typename... Args>                                                                                                                                                         \
+        static constexpr type_name create(Args &&...args)                                                                                                                                             \
+            noexcept(tu::detail::is_nothrow_storable_v<stored_t<tag>, Args...>) {                                                                                                                     \
+            return type_name(tu::in_place_tag<tag>, std::forward<Args>(args)...);                                                                                                                     \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<tag_t tag, typename Allocator, typename... Args>                                                                                                                                     \
+        static constexpr type_name create(std::allocator_arg_t, Allocator &&allocator, Args &&...args) {                                                                                              \
+            return type_name(std::allocator_arg, allocator, tu::in_place_tag<tag>, std::forward<Args>(args)...);                                                                                      \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<typename Self = type_name>                                                                                                                                                           \
+        static std::optional<Self> create_default(tag_t tag) {                                                                                                                                        \
+            if (static_cast<std::size_t>(tag) >= alternative_count) {                                                                                                                                 \
+                return std::nullopt;                                                                                                                                                                  \
+            }                                                                                                                                                                                         \
+            return tu::detail::dispatch_tag<Self>(tag, [](auto selected) -> std::optional<Self> {                                                                                                     \
+                if constexpr (std::is_default_constructible_v<alternative_t<decltype(selected)::value>>) {                                                                                            \
+                    return create<decltype(selected)::value>();                                                                                                                                       \
+                } else {                                                                                                                                                                              \
+                    return std::nullopt;                                                                                                                                                              \
+                }                                                                                                                                                                                     \
+            });                                                                                                                                                                                       \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<typename OutputIt, typename Self = type_name>                                                                                                                                        \
+        static std::optional<OutputIt> create_n(tag_t tag, std::size_t count, OutputIt out) {                                                                                                         \
+            if (static_cast<std::size_t>(tag) >= alternative_count) {                                                                                                                                 \
+                return std::nullopt;                                                                                                                                                                  \
+            }                                                                                                                                                                                         \
+            return tu::detail::dispatch_tag<Self>(tag, [&](auto selected) -> std::optional<OutputIt> {                                                                                                \
+                if constexpr (std::is_default_constructible_v<alternative_t<decltype(selected)::value>>) {                                                                                            \
+                    for (std::size_t i = 0; i < count; ++i) {                                                                                                                                         \
+                        *out = create<decltype(selected)::value>();                                                                                                                                   \
+                        ++out;                                                                                                                                                                        \
+                    }                                                                                                                                                                                 \
+                    return out;                                                                                                                                                                       \
+                } else {                                                                                                                                                                              \
+                    return std::nullopt;                                                                                                                                                              \
+                }                                                                                                                                                                                     \
+            });                                                                                                                                                                                       \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<tag_t tag, typename... Args>                                                                                                                                                         \
+        constexpr alternative_t<tag> &emplace(Args &&...args)                                                                                                                                         \
+            noexcept(tu::detail::is_nothrow_emplaceable_v<stored_t<tag>, Args...>) {                                                                                                                  \
+            UNION_RECORD_TRANSITION(type_name, m_data.tag(), tag);                                                                                                                                    \
+            if constexpr (tu::detail::is_reassignable_v<alternative_t<tag>, Args...>) {                                                                                                               \
+                if (m_data.tag() == tag) {                                                                                                                                                            \
+                    return assign<tag>(std::forward<Args>(args)...);                                                                                                                                  \
+                }                                                                                                                                                                                     \
+            }                                                                                                                                                                                         \
+            std::destroy_at(this);                                                                                                                                                                    \
+            std::construct_at(this, tu::in_place_tag<tag>, std::forward<Args>(args)...);                                                                                                              \
+            return get_ref<tag>();                                                                                                                                                                    \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<tag_t tag, typename Allocator, typename... Args>                                                                                                                                     \
+        constexpr alternative_t<tag> &emplace(std::allocator_arg_t, Allocator &&allocator, Args &&...args) {                                                                                          \
+            UNION_RECORD_TRANSITION(type_name, m_data.tag(), tag);                                                                                                                                    \
+            std::destroy_at(this);                                                                                                                                                                    \
+            std::construct_at(this, std::allocator_arg, allocator, tu::in_place_tag<tag>, std::forward<Args>(args)...);                                                                               \
+            return get_ref<tag>();                                                                                                                                                                    \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<typename Self = type_name>                                                                                                                                                           \
+        bool emplace_from_bytes(tag_t tag, std::span<std::byte const> bytes) {                                                                                                                        \
+            if (static_cast<std::size_t>(tag) >= alternative_count) {                                                                                                                                 \
+                return false;                                                                                                                                                                         \
+            }                                                                                                                                                                                         \
+            return tu::detail::dispatch_tag<Self>(tag, [&](auto selected) {                                                                                                                           \
+                auto alternative = tu::serializer<alternative_t<decltype(selected)::value>>::load(bytes);                                                                                             \
+                if (!alternative) {                                                                                                                                                                   \
+                    return false;                                                                                                                                                                     \
+                }                                                                                                                                                                                     \
+                emplace<decltype(selected)::value>(std::move(*alternative));                                                                                                                          \
+                return true;                                                                                                                                                                          \
+            });                                                                                                                                                                                       \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<tag_t tag>                                                                                                                                                                           \
+        constexpr alternative_t<tag> *get_ptr() {                                                                                                                                                     \
+            return m_data.tag() == tag ? std::addressof(tu::detail::unbox(m_data.m_storage.*member<tag>::pointer)) : nullptr;                                                                         \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<tag_t tag>                                                                                                                                                                           \
+        constexpr alternative_t<tag> const *get_ptr() const {                                                                                                                                         \
+            return m_data.tag() == tag ? std::addressof(tu::detail::unbox(m_data.m_storage.*member<tag>::pointer)) : nullptr;                                                                         \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        UNION_GET_REF_METHODS(type_name)                                                                                                                                                              \
+                                                                                                                                                                                                      \
+        constexpr tag_t get_tag() const {                                                                                                                                                             \
+            return m_data.tag();                                                                                                                                                                      \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<tag_t tag>                                                                                                                                                                           \
+        constexpr bool holds() const {                                                                                                                                                                \
+            return m_data.tag() == tag;                                                                                                                                                               \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        UNION_VISIT_METHODS(type_name, __VA_ARGS__)                                                                                                                                                   \
+                                                                                                                                                                                                      \
+        FOR_EACH(UNION_SPECIFIC_METHOD, (type_name), __VA_ARGS__)                                                                                                                                     \
+                                                                                                                                                                                                      \
+        template<typename Derived>                                                                                                                                                                    \
+        struct named_accessors {                                                                                                                                                                      \
+            FOR_EACH(UNION_NAMED_ACCESSOR, (type_name), __VA_ARGS__)                                                                                                                                  \
+        };                                                                                                                                                                                            \
+                                                                                                                                                                                                      \
+        template<typename Derived>                                                                                                                                                                    \
+        struct named_push_back {                                                                                                                                                                      \
+            FOR_EACH(UNION_NAMED_PUSH_BACK, (type_name), __VA_ARGS__)                                                                                                                                 \
+        };                                                                                                                                                                                            \
+                                                                                                                                                                                                      \
+        UNION_MATCH_METHODS(type_name, __VA_ARGS__)                                                                                                                                                   \
+                                                                                                                                                                                                      \
+    private:                                                                                                                                                                                          \
+        UNION_TRAITS(type_name, __VA_ARGS__)                                                                                                                                                          \
+                                                                                                                                                                                                      \
+        template<typename = void>                                                                                                                                                                     \
+        union storage_template {                                                                                                                                                                      \
+            constexpr storage_template() {}                                                                                                                                                           \
+            storage_template(storage_template const &) = default;                                                                                                                                     \
+            storage_template(storage_template &&) = default;                                                                                                                                          \
+            storage_template &operator=(storage_template const &) = default;                                                                                                                          \
+            storage_template &operator=(storage_template &&) = default;                                                                                                                               \
+            ~storage_template() requires(trivially_destructible) = default;                                                                                                                           \
+            constexpr ~storage_template() requires(!trivially_destructible) {}                                                                                                                        \
+            FOR_EACH(UNION_STORAGE_FIELD, (type_name), __VA_ARGS__)                                                                                                                                   \
+        };                                                                                                                                                                                            \
+                                                                                                                                                                                                      \
+        using storage_t = storage_template<>;                                                                                                                                                         \
+                                                                                                                                                                                                      \
+        template<tag_t tag, typename = void>                                                                                                                                                          \
+        struct member;                                                                                                                                                                                \
+        FOR_EACH(UNION_MEMBER_POINTER, (type_name), __VA_ARGS__)                                                                                                                                      \
+                                                                                                                                                                                                      \
+        using fields_t = std::conditional_t<niche_carrier != SIZE_MAX,                                                                                                                                \
+            tu::detail::niche_fields<tag_t, storage_t, niche_carrier_or_zero, stored_t<tag_t(niche_carrier_or_zero)>>,                                                                                \
+            typename layout_policy::template fields<tag_t, storage_t>>;                                                                                                                               \
+                                                                                                                                                                                                      \
+        template<tag_t tag, typename Arg>                                                                                                                                                             \
+        constexpr alternative_t<tag> &assign(Arg &&arg) {                                                                                                                                             \
+            get_ref<tag>() = std::forward<Arg>(arg);                                                                                                                                                  \
+            return get_ref<tag>();                                                                                                                                                                    \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<tag_t tag, typename ReturnType, typename Self, typename Visitor>                                                                                                                     \
+        static constexpr ReturnType visit_arm(Self &&self, Visitor &&visitor) {                                                                                                                       \
+            if constexpr (requires { std::forward<Visitor>(visitor)(tu::in_place_tag<tag>, std::forward<Self>(self).template get_ref<tag>()); }) {                                                    \
+                return std::forward<Visitor>(visitor)(tu::in_place_tag<tag>, std::forward<Self>(self).template get_ref<tag>());                                                                       \
+            } else if constexpr (requires { std::forward<Visitor>(visitor)(std::forward<Self>(self)); }) {                                                                                            \
+                return std::forward<Visitor>(visitor)(std::forward<Self>(self));                                                                                                                      \
+            } else {                                                                                                                                                                                  \
+                static_assert(tu::detail::always_false_v<Visitor>, "visit: the visitor accepts neither an alternative nor the union");                                                                \
+            }                                                                                                                                                                                         \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<tag_t tag, typename ReturnType, typename Self, typename Matcher>                                                                                                                     \
+        static constexpr ReturnType match_arm(Self &&self, Matcher &&matcher) {                                                                                                                       \
+            FOR_EACH(UNION_MATCH_ARM, (type_name), __VA_ARGS__)                                                                                                                                       \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<typename ReturnType, typename Self, typename Visitor>                                                                                                                                \
+        static constexpr ReturnType (*visit_table_v[])(Self &&, Visitor &&) = {FOR_EACH(UNION_VISIT_TABLE_ENTRY, (type_name), __VA_ARGS__)};                                                          \
+                                                                                                                                                                                                      \
+        template<typename ReturnType, typename Self, typename Visitor>                                                                                                                                \
+        static constexpr ReturnType visit_table_impl(Self &&self, Visitor &&visitor) {                                                                                                                \
+            UNION_RECORD_VISIT(type_name, self.get_tag());                                                                                                                                            \
+            return visit_table_v<ReturnType, Self, Visitor>[static_cast<std::size_t>(self.get_tag())](std::forward<Self>(self), std::forward<Visitor>(visitor));                                      \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<typename = void>                                                                                                                                                                     \
+        struct data_template : fields_t {                                                                                                                                                             \
+            template<tag_t tag, typename... Args>                                                                                                                                                     \
+            constexpr data_template(tu::in_place_tag_t<tag>, Args &&...args)                                                                                                                          \
+                noexcept(tu::detail::is_nothrow_storable_v<stored_t<tag>, Args...>) {                                                                                                                 \
+                tu::detail::store(std::addressof(this->m_storage.*member<tag>::pointer), std::forward<Args>(args)...);                                                                                \
+                this->set_tag(tag);                                                                                                                                                                   \
+            }                                                                                                                                                                                         \
+                                                                                                                                                                                                      \
+            template<typename Allocator, tag_t tag, typename... Args>                                                                                                                                 \
+            constexpr data_template(std::allocator_arg_t, Allocator const &allocator, tu::in_place_tag_t<tag>, Args &&...args) {                                                                      \
+                tu::detail::store_using_allocator(std::addressof(this->m_storage.*member<tag>::pointer), allocator, std::forward<Args>(args)...);                                                     \
+                this->set_tag(tag);                                                                                                                                                                   \
+            }                                                                                                                                                                                         \
+                                                                                                                                                                                                      \
+            template<typename Allocator>                                                                                                                                                              \
+            constexpr data_template(std::allocator_arg_t, Allocator const &allocator, data_template const &other)                                                                                     \
+                requires(copy_constructible) {                                                                                                                                                        \
+                tag_t tag = other.tag();                                                                                                                                                              \
+                switch (tag) {                                                                                                                                                                        \
+                    FOR_EACH(UNION_ALLOCATOR_CONSTRUCT_CASE, (type_name, (other)), __VA_ARGS__)                                                                                                       \
+                default:                                                                                                                                                                              \
+                    TU_INVALID_TAG();                                                                                                                                                                 \
+                }                                                                                                                                                                                     \
+                this->set_tag(tag);                                                                                                                                                                   \
+            }                                                                                                                                                                                         \
+                                                                                                                                                                                                      \
+            template<typename Allocator>                                                                                                                                                              \
+            constexpr data_template(std::allocator_arg_t, Allocator const &allocator, data_template &&other)                                                                                          \
+                requires(move_constructible) {                                                                                                                                                        \
+                tag_t tag = other.tag();                                                                                                                                                              \
+                switch (tag) {                                                                                                                                                                        \
+                    FOR_EACH(UNION_ALLOCATOR_CONSTRUCT_CASE, (type_name, std::move(other)), __VA_ARGS__)                                                                                              \
+                default:                                                                                                                                                                              \
+                    TU_INVALID_TAG();                                                                                                                                                                 \
+                }                                                                                                                                                                                     \
+                this->set_tag(tag);                                                                                                                                                                   \
+            }                                                                                                                                                                                         \
+                                                                                                                                                                                                      \
+            data_template(data_template const &) requires(trivially_copy_constructible) = default;                                                                                                    \
+            constexpr data_template(data_template const &other) noexcept(nothrow_copy_constructible)                                                                                                  \
+                requires(copy_constructible && !trivially_copy_constructible) {                                                                                                                       \
+                tag_t tag = other.tag();                                                                                                                                                              \
+                switch (tag) {                                                                                                                                                                        \
+                    FOR_EACH(UNION_COPY_CASE, (type_name), __VA_ARGS__)                                                                                                                               \
+                default:                                                                                                                                                                              \
+                    TU_INVALID_TAG();                                                                                                                                                                 \
+                }                                                                                                                                                                                     \
+                this->set_tag(tag);                                                                                                                                                                   \
+            }                                                                                                                                                                                         \
+                                                                                                                                                                                                      \
+            data_template(data_template &&) requires(trivially_move_constructible) = default;                                                                                                         \
+            constexpr data_template(data_template &&other) noexcept(nothrow_move_constructible)                                                                                                       \
+                requires(move_constructible && !trivially_move_constructible) {                                                                                                                       \
+                tag_t tag = other.tag();                                                                                                                                                              \
+                switch (tag) {                                                                                                                                                                        \
+                    FOR_EACH(UNION_MOVE_CASE, (type_name), __VA_ARGS__)                                                                                                                               \
+                default:                                                                                                                                                                              \
+                    TU_INVALID_TAG();                                                                                                                                                                 \
+                }                                                                                                                                                                                     \
+                this->set_tag(tag);                                                                                                                                                                   \
+            }                                                                                                                                                                                         \
+                                                                                                                                                                                                      \
+            ~data_template() requires(trivially_destructible) = default;                                                                                                                              \
+            constexpr ~data_template() requires(!trivially_destructible) {                                                                                                                            \
+                switch (this->tag()) {                                                                                                                                                                \
+                    FOR_EACH(UNION_DESTRUCT_CASE, (type_name), __VA_ARGS__)                                                                                                                           \
+                default:                                                                                                                                                                              \
+                    TU_INVALID_TAG();                                                                                                                                                                 \
+                }                                                                                                                                                                                     \
+            }                                                                                                                                                                                         \
+                                                                                                                                                                                                      \
+            data_template &operator=(data_template const &) requires(trivially_copy_assignable) = default;                                                                                            \
+            constexpr data_template &operator=(data_template const &other) noexcept(nothrow_copy_assignable)                                                                                          \
+                requires(copy_constructible && !trivially_copy_assignable) {                                                                                                                          \
+                if (this != &other) {                                                                                                                                                                 \
+                    if (this->tag() == other.tag()) {                                                                                                                                                 \
+                        switch (this->tag()) {                                                                                                                                                        \
+                            FOR_EACH(UNION_COPY_ASSIGN_CASE, (type_name), __VA_ARGS__)                                                                                                                \
+                        default:                                                                                                                                                                      \
+                            TU_INVALID_TAG();                                                                                                                                                         \
+                        }                                                                                                                                                                             \
+                    }                                                                                                                                                                                 \
+                    std::destroy_at(this);                                                                                                                                                            \
+                    std::construct_at(this, (other));                                                                                                                                                 \
+                }                                                                                                                                                                                     \
+                return *this;                                                                                                                                                                         \
+            }                                                                                                                                                                                         \
+                                                                                                                                                                                                      \
+            data_template &operator=(data_template &&) requires(trivially_move_assignable) = default;                                                                                                 \
+            constexpr data_template &operator=(data_template &&other) noexcept(nothrow_move_assignable)                                                                                               \
+                requires(move_constructible && !trivially_move_assignable) {                                                                                                                          \
+                if (this != &other) {                                                                                                                                                                 \
+                    if (this->tag() == other.tag()) {                                                                                                                                                 \
+                        switch (this->tag()) {                                                                                                                                                        \
+                            FOR_EACH(UNION_MOVE_ASSIGN_CASE, (type_name), __VA_ARGS__)                                                                                                                \
+                        default:                                                                                                                                                                      \
+                            TU_INVALID_TAG();                                                                                                                                                         \
+                        }                                                                                                                                                                             \
+                    }                                                                                                                                                                                 \
+                    std::destroy_at(this);                                                                                                                                                            \
+                    std::construct_at(this, std::move(other));                                                                                                                                        \
+                }                                                                                                                                                                                     \
+                return *this;                                                                                                                                                                         \
+            }                                                                                                                                                                                         \
+        };                                                                                                                                                                                            \
+                                                                                                                                                                                                      \
+        using data_t = data_template<>;                                                                                                                                                               \
+                                                                                                                                                                                                      \
+        data_t m_data;                                                                                                                                                                                \
+                                                                                                                                                                                                      \
+    public:                                                                                                                                                                                           \
+        template<typename Allocator>                                                                                                                                                                  \
+        constexpr type_name(std::allocator_arg_t, Allocator const &allocator, type_name const &other)                                                                                                 \
+            requires(copy_constructible)                                                                                                                                                              \
+            : m_data(std::allocator_arg, allocator, other.m_data) {}                                                                                                                                  \
+                                                                                                                                                                                                      \
+        template<typename Allocator>                                                                                                                                                                  \
+        constexpr type_name(std::allocator_arg_t, Allocator const &allocator, type_name &&other)                                                                                                      \
+            requires(move_constructible)                                                                                                                                                              \
+            : m_data(std::allocator_arg, allocator, std::move(other.m_data)) {}                                                                                                                       \
+                                                                                                                                                                                                      \
+        UNION_STATS(type_name)                                                                                                                                                                        \
+                                                                                                                                                                                                      \
+        static constexpr tu::layout_info layout_info() noexcept {                                                                                                                                     \
+            return {                                                                                                                                                                                  \
+                sizeof(type_name),                                                                                                                                                                    \
+                alignof(type_name),                                                                                                                                                                   \
+                fields_t::tag_size,                                                                                                                                                                   \
+                fields_t::tag_offset,                                                                                                                                                                 \
+                sizeof(storage_t),                                                                                                                                                                    \
+                fields_t::storage_offset,                                                                                                                                                             \
+                sizeof(type_name) - fields_t::tag_size - std::max({FOR_EACH(UNION_ALTERNATIVE_SIZE, (type_name), __VA_ARGS__) std::size_t(0)}),                                                       \
+            };                                                                                                                                                                                        \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<typename Self = type_name>                                                                                                                                                           \
+            requires(tu::detail::comparison_traits<Self>::equality_comparable)                                                                                                                        \
+        constexpr bool operator==(type_name const &other) const {                                                                                                                                     \
+            if constexpr (tu::detail::comparison_traits<Self>::bitwise_comparable && std::min({FOR_EACH(UNION_ALTERNATIVE_SIZE, (type_name), __VA_ARGS__) sizeof(storage_t)}) == sizeof(storage_t)) { \
+                if (!std::is_constant_evaluated()) {                                                                                                                                                  \
+                    return m_data.tag() == other.m_data.tag() && std::memcmp(&m_data.m_storage, &other.m_data.m_storage, sizeof(storage_t)) == 0;                                                     \
+                }                                                                                                                                                                                     \
+            }                                                                                                                                                                                         \
+            if (m_data.tag() != other.m_data.tag()) {                                                                                                                                                 \
+                return false;                                                                                                                                                                         \
+            }                                                                                                                                                                                         \
+            Self const &self = *this;                                                                                                                                                                 \
+            switch (m_data.tag()) {                                                                                                                                                                   \
+                FOR_EACH(UNION_EQUAL_CASE, (type_name), __VA_ARGS__)                                                                                                                                  \
+            default:                                                                                                                                                                                  \
+                TU_INVALID_TAG();                                                                                                                                                                     \
+            }                                                                                                                                                                                         \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<typename Self = type_name>                                                                                                                                                           \
+            requires(tu::detail::comparison_traits<Self>::three_way_comparable)                                                                                                                       \
+        constexpr typename tu::detail::comparison_category<Self>::type operator<=>(type_name const &other) const {                                                                                    \
+            if (auto order = m_data.tag() <=> other.m_data.tag(); order != 0) {                                                                                                                       \
+                return order;                                                                                                                                                                         \
+            }                                                                                                                                                                                         \
+            Self const &self = *this;                                                                                                                                                                 \
+            switch (m_data.tag()) {                                                                                                                                                                   \
+                FOR_EACH(UNION_COMPARE_CASE, (type_name), __VA_ARGS__)                                                                                                                                \
+            default:                                                                                                                                                                                  \
+                TU_INVALID_TAG();                                                                                                                                                                     \
+            }                                                                                                                                                                                         \
+        }                                                                                                                                                                                             \
+                                                                                                                                                                                                      \
+        template<typename Self = type_name>                                                                                                                                                           \
+            requires(tu::detail::comparison_traits<Self>::hashable)                                                                                                                                   \
+        std::size_t hash_value() const noexcept {                                                                                                                                                     \
+            if constexpr (tu::detail::comparison_traits<Self>::bitwise_comparable && std::min({FOR_EACH(UNION_ALTERNATIVE_SIZE, (type_name), __VA_ARGS__) sizeof(storage_t)}) == sizeof(storage_t)) { \
+                return tu::detail::hash_combine(static_cast<std::size_t>(m_data.tag()), tu::detail::hash_bytes(&m_data.m_storage, sizeof(storage_t)));                                                \
+            } else {                                                                                                                                                                                  \
+                Self const &self = *this;                                                                                                                                                             \
+                switch (m_data.tag()) {                                                                                                                                                               \
+                    FOR_EACH(UNION_HASH_CASE, (type_name), __VA_ARGS__)                                                                                                                               \
+                default:                                                                                                                                                                              \
+                    TU_INVALID_TAG();                                                                                                                                                                 \
+                }                                                                                                                                                                                     \
+            }                                                                                                                                                                                         \
+        }                                                                                                                                                                                             \
     }
 
 // Pattern matching implementation
@@ -406,6 +1254,70 @@
 #define MATCH(return_type, value, ...) \
     (value).visit<return_type>(tu::combined_visitor{FOR_EACH(MATCH_GEN_FUNC, (return_type, value), __VA_ARGS__)})
 
+#define MATCH_SWITCH_GEN_COVER(mems, args) MATCH_SWITCH_GEN_COVER_CALL((UNPACK mems, UNPACK args))
+#define MATCH_SWITCH_GEN_COVER_CALL(sums) MATCH_SWITCH_GEN_COVER_IMPL sums
+#define MATCH_SWITCH_GEN_COVER_IMPL(union_type, kind, ...) MATCH_SWITCH_GEN_##kind##_COVER(union_type, __VA_ARGS__)
+#define MATCH_SWITCH_GEN_CASE_COVER(union_type, field_name, var_name, block) | union_type::tag_t::field_name
+#define MATCH_SWITCH_GEN_OTHERWISE_COVER(union_type, var_name, block) | tu::detail::match_otherwise
+
+#define MATCH_SWITCH_GEN_ARM(mems, args) MATCH_SWITCH_GEN_ARM_CALL((UNPACK mems, UNPACK args))
+#define MATCH_SWITCH_GEN_ARM_CALL(sums) MATCH_SWITCH_GEN_ARM_IMPL sums
+#define MATCH_SWITCH_GEN_ARM_IMPL(return_type, union_type, value, kind, ...) MATCH_SWITCH_GEN_##kind##_ARM(return_type, union_type, value, __VA_ARGS__)
+#define MATCH_SWITCH_GEN_CASE_ARM(return_type, union_type, value, field_name, var_name, block)            \
+    case union_type::tag_t::field_name: {                                                                 \
+        [[maybe_unused]] auto &&var_name = std::forward<decltype(value)>(value).get_##field_name##_ref(); \
+        return tu::detail::match_switch_arm<return_type>([&]() block);                                    \
+    }
+#define MATCH_SWITCH_GEN_OTHERWISE_ARM(return_type, union_type, value, var_name, block)
+
+#define MATCH_SWITCH_GEN_DEFAULT(mems, args) MATCH_SWITCH_GEN_DEFAULT_CALL((UNPACK mems, UNPACK args))
+#define MATCH_SWITCH_GEN_DEFAULT_CALL(sums) MATCH_SWITCH_GEN_DEFAULT_IMPL sums
+#define MATCH_SWITCH_GEN_DEFAULT_IMPL(return_type, value, kind, ...) MATCH_SWITCH_GEN_##kind##_DEFAULT(return_type, value, __VA_ARGS__)
+#define MATCH_SWITCH_GEN_CASE_DEFAULT(return_type, value, field_name, var_name, block)
+#define MATCH_SWITCH_GEN_OTHERWISE_DEFAULT(return_type, value, var_name, block)  \
+    {                                                                            \
+        [[maybe_unused]] auto &&var_name = std::forward<decltype(value)>(value); \
+        return tu::detail::match_switch_arm<return_type>([&]() block);           \
+    }
+
+// Same arms as MATCH, lowered to one switch on the tag inside a single lambda instead of an overload set passed to visit.
+// Each block runs as a lambda of its own, so that, as in MATCH, a block that does not return a value does not compile.
+#define MATCH_SWITCH(return_type, value, ...)                                                                                                      \
+    [&]() -> return_type {                                                                                                                         \
+        auto &&tu_match_value = (value);                                                                                                           \
+        using tu_match_union = std::remove_cvref_t<decltype(tu_match_value)>;                                                                      \
+        static_assert((tu::detail::match_coverage<tu_match_union>{} FOR_EACH(MATCH_SWITCH_GEN_COVER, (tu_match_union), __VA_ARGS__)).exhaustive(), \
+            "MATCH_SWITCH needs a CASE for every alternative or an OTHERWISE");                                                                    \
+        UNION_RECORD_VISIT(tu_match_union, tu_match_value.get_tag());                                                                              \
+        switch (tu_match_value.get_tag()) {                                                                                                        \
+            FOR_EACH(MATCH_SWITCH_GEN_ARM, (return_type, tu_match_union, tu_match_value), __VA_ARGS__)                                             \
+        default:                                                                                                                                   \
+            FOR_EACH(MATCH_SWITCH_GEN_DEFAULT, (return_type, tu_match_value), __VA_ARGS__)                                                         \
+            break;                                                                                                                                 \
+        }                                                                                                                                          \
+        if constexpr (!std::is_void_v<return_type>) {                                                                                              \
+            TU_INVALID_TAG();                                                                                                                      \
+        }                                                                                                                                          \
+    }()
+
+#define MATCH2_GEN_FUNC(mems, args) MATCH2_GEN_FUNC_CALL((UNPACK mems, UNPACK args))
+#define MATCH2_GEN_FUNC_CALL(sums) MATCH2_GEN_FUNC_IMPL sums
+#define MATCH2_GEN_FUNC_IMPL(return_type, lhs, rhs, kind, ...) \
+    MATCH2_GEN_##kind##_FUNC(return_type, lhs, rhs, __VA_ARGS__)
+
+#define CASE2(lhs_field_name, rhs_field_name, lhs_var_name, rhs_var_name, block) (CASE2, lhs_field_name, rhs_field_name, lhs_var_name, rhs_var_name, block)
+#define MATCH2_GEN_CASE2_FUNC(return_type, lhs, rhs, lhs_field_name, rhs_field_name, lhs_var_name, rhs_var_name, block) \
+    [&](tu::in_place_tag_t<std::remove_reference_t<decltype((lhs))>::tag_t::lhs_field_name>,                            \
+        tu::in_place_tag_t<std::remove_reference_t<decltype((rhs))>::tag_t::rhs_field_name>,                            \
+        auto &&lhs_var_name, auto &&rhs_var_name) block,
+
+#define OTHERWISE2(lhs_var_name, rhs_var_name, block) (OTHERWISE2, lhs_var_name, rhs_var_name, block)
+#define MATCH2_GEN_OTHERWISE2_FUNC(return_type, lhs, rhs, lhs_var_name, rhs_var_name, block) \
+    [&](auto &&lhs_var_name, auto &&rhs_var_name) block,
+
+#define MATCH2(return_type, lhs, rhs, ...) \
+    tu::visit<return_type>(tu::combined_visitor{FOR_EACH(MATCH2_GEN_FUNC, (return_type, lhs, rhs), __VA_ARGS__)}, (lhs), (rhs))
+
 namespace tu {
 template<auto tag>
 struct in_place_tag_t {
@@ -422,4 +1334,1116 @@ struct combined_visitor : Visitors... {
 
 template<typename... Visitors>
 combined_visitor(Visitors...) -> combined_visitor<Visitors...>;
+
+// Binary encoding of an alternative, defined in serialize.hpp, which emplace_from_bytes needs
+template<typename T>
+struct serializer;
+
+struct layout_info {
+    std::size_t size;
+    std::size_t align;
+    std::size_t tag_size;
+    std::size_t tag_offset;
+    std::size_t storage_size;
+    std::size_t storage_offset;
+    std::size_t wasted; // bytes used by neither the tag nor the largest alternative
+};
+
+// Tag frequencies of a union, e.g. its visit counts from stats() under TU_INSTRUMENT. Specializations provide
+//   static constexpr std::array<std::uint64_t, Union::alternative_count> frequencies;
+// and make visit and match (and thus MATCH) test the most frequent alternatives first, in order of frequency, and
+// call the alternatives below 1% of all visits out of line. They must be declared before the first visit.
+template<typename Union>
+struct dispatch_profile {};
+
+#if defined(TU_INSTRUMENT)
+// Counts recorded by the generated methods of a union when TU_INSTRUMENT is defined, summed over all threads
+template<std::size_t N>
+struct union_stats {
+    std::array<std::uint64_t, N> visits{};                     // visit, visit_table, visit_expect and match, by tag
+    std::array<std::array<std::uint64_t, N>, N> transitions{}; // emplace, by previous tag and new tag
+};
+#endif
+
+// Invalid object representations of T that can encode the tag of a union (niche optimization).
+// Specializations provide:
+//   static constexpr std::size_t count;                 number of invalid representations
+//   static void store(void *p, std::size_t i) noexcept; write the i-th invalid representation to p
+//   static std::size_t load(void const *p) noexcept;    index of the invalid representation at p, or count if p holds a valid T
+template<typename T>
+struct niche {
+    static constexpr std::size_t count = 0;
+};
+
+template<>
+struct niche<bool> {
+    static constexpr std::size_t count = UINT8_MAX - 1;
+
+    static void store(void *p, std::size_t i) noexcept {
+        unsigned char byte = static_cast<unsigned char>(i + 2);
+        std::memcpy(p, &byte, 1);
+    }
+
+    static std::size_t load(void const *p) noexcept {
+        unsigned char byte;
+        std::memcpy(&byte, p, 1);
+        return byte < 2 ? count : byte - 2;
+    }
+};
+
+// Misaligned addresses are never valid pointers to T
+template<typename T>
+    requires(std::is_object_v<T> && requires { alignof(T); })
+struct niche<T *> {
+    static constexpr std::size_t count = alignof(T) - 1;
+
+    static void store(void *p, std::size_t i) noexcept {
+        std::uintptr_t bits = i + 1;
+        std::memcpy(p, &bits, sizeof(bits));
+    }
+
+    static std::size_t load(void const *p) noexcept {
+        std::uintptr_t bits;
+        std::memcpy(&bits, p, sizeof(bits));
+        return bits != 0 && bits < alignof(T) ? bits - 1 : count;
+    }
+};
+
+// Allocator used by tu::boxed<T>, specialize to allocate boxed alternatives from a pool.
+// The allocator is default constructed for every allocation and deallocation.
+template<typename T>
+struct box_allocator {
+    using type = std::allocator<T>;
+};
+
+// Alternative stored behind a pointer, declared as `(BOXED(T), name)`.
+// Moved-from boxes are empty and may only be destroyed or assigned to.
+template<typename T>
+struct boxed {
+public:
+    using allocator_type = typename box_allocator<T>::type;
+
+    template<typename... Args>
+    constexpr explicit boxed(std::in_place_t, Args &&...args)
+        : m_ptr(allocate([&](allocator_type &allocator, T *ptr) {
+              std::allocator_traits<allocator_type>::construct(allocator, ptr, std::forward<Args>(args)...);
+          })) {}
+
+    // The box itself still comes from box_allocator, the allocator is passed on to the boxed value
+    template<typename Allocator, typename... Args>
+    constexpr boxed(std::allocator_arg_t, Allocator const &inner, Args &&...args)
+        : m_ptr(allocate([&](allocator_type &, T *ptr) {
+              std::uninitialized_construct_using_allocator(ptr, inner, std::forward<Args>(args)...);
+          })) {}
+
+    constexpr boxed(boxed const &other)
+        requires std::is_copy_constructible_v<T>
+        : m_ptr(other.m_ptr ? allocate([&](allocator_type &allocator, T *ptr) {
+              std::allocator_traits<allocator_type>::construct(allocator, ptr, *other.m_ptr);
+          })
+                            : nullptr) {}
+
+    constexpr boxed(boxed &&other) noexcept
+        : m_ptr(std::exchange(other.m_ptr, nullptr)) {}
+
+    constexpr boxed &operator=(boxed const &other)
+        requires std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>
+    {
+        if (m_ptr && other.m_ptr) {
+            *m_ptr = *other.m_ptr;
+        } else {
+            boxed copy(other);
+            std::swap(m_ptr, copy.m_ptr);
+        }
+        return *this;
+    }
+
+    constexpr boxed &operator=(boxed &&other) noexcept {
+        std::swap(m_ptr, other.m_ptr);
+        return *this;
+    }
+
+    constexpr ~boxed() {
+        if (m_ptr) {
+            allocator_type allocator;
+            std::allocator_traits<allocator_type>::destroy(allocator, m_ptr);
+            std::allocator_traits<allocator_type>::deallocate(allocator, m_ptr, 1);
+        }
+    }
+
+    constexpr T &get() noexcept {
+        return *m_ptr;
+    }
+
+    constexpr T const &get() const noexcept {
+        return *m_ptr;
+    }
+
+private:
+    template<typename Construct>
+    static constexpr T *allocate(Construct &&construct) {
+        allocator_type allocator;
+        T *ptr = std::allocator_traits<allocator_type>::allocate(allocator, 1);
+        try {
+            construct(allocator, ptr);
+        } catch (...) {
+            std::allocator_traits<allocator_type>::deallocate(allocator, ptr, 1);
+            throw;
+        }
+        return ptr;
+    }
+
+    T *m_ptr;
+};
+
+template<typename T>
+struct rec;
+
+// Storage for the nodes of tu::rec<T>. Nodes are carved from chunks of `chunk_size` and recycled through a free list,
+// which keeps the nodes of a tree close in memory and replaces a heap allocation per node by a pointer bump.
+// A pool is not thread-safe and must outlive the nodes allocated from it.
+// In bulk mode nodes are never destroyed one by one: destroying a tu::rec is a no-op, and the pool releases all of its
+// nodes at once without running their destructors, so tearing down a tree costs one deallocation per chunk. Values
+// in a bulk pool must not own other resources, e.g. use std::pmr strings from an arena that lives as long as the pool.
+template<typename T>
+struct node_pool {
+public:
+    struct node {
+        node() noexcept {}
+        ~node() {}
+
+        node_pool *m_owner;
+        union {
+            node *m_next;
+            T m_value;
+        };
+    };
+
+    explicit node_pool(bool bulk = false, std::size_t chunk_size = 64) noexcept
+        : m_bulk(bulk), m_chunk_size(std::max(chunk_size, std::size_t(2))) {}
+
+    node_pool(node_pool const &) = delete;
+    node_pool &operator=(node_pool const &) = delete;
+
+    ~node_pool() {
+        std::allocator<node> allocator;
+        for (node *chunk = m_chunks; chunk;) {
+            node *previous = chunk->m_next;
+            allocator.deallocate(chunk, m_chunk_size);
+            chunk = previous;
+        }
+    }
+
+    bool bulk() const noexcept {
+        return m_bulk;
+    }
+
+    // Pool in which tu::rec<T> allocates its nodes on this thread, or nullptr for the heap, see node_scope
+    static node_pool *current() noexcept {
+        return s_current;
+    }
+
+    node *allocate() {
+        node *n = m_free;
+        if (n) {
+            m_free = n->m_next;
+        } else {
+            if (m_bump == m_end) {
+                // The first node of a chunk links the chunks together
+                node *chunk = std::construct_at(std::allocator<node>().allocate(m_chunk_size));
+                chunk->m_owner = this;
+                chunk->m_next = m_chunks;
+                m_chunks = chunk;
+                m_bump = chunk + 1;
+                m_end = chunk + m_chunk_size;
+            }
+            n = std::construct_at(m_bump++);
+        }
+        n->m_owner = this;
+        return n;
+    }
+
+    void deallocate(node *n) noexcept {
+        n->m_next = m_free;
+        m_free = n;
+    }
+
+private:
+    template<typename U>
+    friend struct node_scope;
+
+    static inline thread_local node_pool *s_current = nullptr;
+
+    bool m_bulk;
+    std::size_t m_chunk_size;
+    node *m_chunks = nullptr;
+    node *m_free = nullptr;
+    node *m_bump = nullptr;
+    node *m_end = nullptr;
+};
+
+// Makes pool the pool of tu::rec<T> on this thread until the scope ends
+template<typename T>
+struct node_scope {
+public:
+    explicit node_scope(node_pool<T> &pool) noexcept
+        : m_previous(std::exchange(node_pool<T>::s_current, &pool)) {}
+
+    node_scope(node_scope const &) = delete;
+    node_scope &operator=(node_scope const &) = delete;
+
+    ~node_scope() {
+        node_pool<T>::s_current = m_previous;
+    }
+
+private:
+    node_pool<T> *m_previous;
+};
+
+// Recursive alternative holding one T, declared as `(tu::rec<Self>, name)` while Self is still incomplete.
+// Copies are deep and allocate from the current node_pool<T>, moved-from recs are empty and may only be destroyed or
+// assigned to. Comparison and hashing forward to T without constraints, so that they can be declared for an
+// incomplete T; the ordering is always std::partial_ordering.
+template<typename T>
+struct rec {
+public:
+    using element_type = T;
+
+    template<typename... Args>
+    explicit rec(std::in_place_t, Args &&...args)
+        : m_node(create(std::forward<Args>(args)...)) {}
+
+    rec(rec const &other)
+        : m_node(other.m_node ? create(other.m_node->m_value) : nullptr) {}
+
+    rec(rec &&other) noexcept
+        : m_node(std::exchange(other.m_node, nullptr)) {}
+
+    rec &operator=(rec const &other) {
+        if (m_node && other.m_node) {
+            m_node->m_value = other.m_node->m_value;
+        } else {
+            rec copy(other);
+            std::swap(m_node, copy.m_node);
+        }
+        return *this;
+    }
+
+    rec &operator=(rec &&other) noexcept {
+        std::swap(m_node, other.m_node);
+        return *this;
+    }
+
+    ~rec() {
+        if (!m_node) {
+            return;
+        }
+        node_pool<T> *owner = m_node->m_owner;
+        if (!owner) {
+            std::destroy_at(std::addressof(m_node->m_value));
+            std::allocator<node_t>().deallocate(m_node, 1);
+        } else if (!owner->bulk()) {
+            std::destroy_at(std::addressof(m_node->m_value));
+            owner->deallocate(m_node);
+        }
+    }
+
+    T &operator*() noexcept {
+        return m_node->m_value;
+    }
+
+    T const &operator*() const noexcept {
+        return m_node->m_value;
+    }
+
+    T *operator->() noexcept {
+        return std::addressof(m_node->m_value);
+    }
+
+    T const *operator->() const noexcept {
+        return std::addressof(m_node->m_value);
+    }
+
+    friend bool operator==(rec const &lhs, rec const &rhs) {
+        return *lhs == *rhs;
+    }
+
+    friend std::partial_ordering operator<=>(rec const &lhs, rec const &rhs) {
+        return *lhs <=> *rhs;
+    }
+
+private:
+    using node_t = typename node_pool<T>::node;
+
+    template<typename... Args>
+    static node_t *create(Args &&...args) {
+        node_pool<T> *pool = node_pool<T>::current();
+        node_t *n;
+        if (pool) {
+            n = pool->allocate();
+        } else {
+            n = std::construct_at(std::allocator<node_t>().allocate(1));
+            n->m_owner = nullptr;
+        }
+        try {
+            std::construct_at(std::addressof(n->m_value), std::forward<Args>(args)...);
+        } catch (...) {
+            if (pool) {
+                pool->deallocate(n);
+            } else {
+                std::allocator<node_t>().deallocate(n, 1);
+            }
+            throw;
+        }
+        return n;
+    }
+
+    node_t *m_node;
+};
+
+// Recursive alternative holding a sequence of T, declared as `(tu::rec_vec<Self>, name)` while Self is still
+// incomplete. The elements are stored contiguously in a std::vector, comparison and hashing are as for tu::rec.
+template<typename T>
+struct rec_vec {
+public:
+    using value_type = T;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    rec_vec() = default;
+
+    rec_vec(std::initializer_list<T> values)
+        : m_values(values) {}
+
+    template<typename Iterator>
+    rec_vec(Iterator first, Iterator last)
+        : m_values(first, last) {}
+
+    std::size_t size() const noexcept {
+        return m_values.size();
+    }
+
+    bool empty() const noexcept {
+        return m_values.empty();
+    }
+
+    T &operator[](std::size_t index) noexcept {
+        return m_values[index];
+    }
+
+    T const &operator[](std::size_t index) const noexcept {
+        return m_values[index];
+    }
+
+    T *data() noexcept {
+        return m_values.data();
+    }
+
+    T const *data() const noexcept {
+        return m_values.data();
+    }
+
+    iterator begin() noexcept {
+        return m_values.begin();
+    }
+
+    iterator end() noexcept {
+        return m_values.end();
+    }
+
+    const_iterator begin() const noexcept {
+        return m_values.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return m_values.end();
+    }
+
+    void reserve(std::size_t capacity) {
+        m_values.reserve(capacity);
+    }
+
+    template<typename... Args>
+    T &emplace_back(Args &&...args) {
+        return m_values.emplace_back(std::forward<Args>(args)...);
+    }
+
+    void push_back(T const &value) {
+        m_values.push_back(value);
+    }
+
+    void push_back(T &&value) {
+        m_values.push_back(std::move(value));
+    }
+
+    void pop_back() {
+        m_values.pop_back();
+    }
+
+    void clear() noexcept {
+        m_values.clear();
+    }
+
+    friend bool operator==(rec_vec const &lhs, rec_vec const &rhs) {
+        return lhs.m_values == rhs.m_values;
+    }
+
+    friend std::partial_ordering operator<=>(rec_vec const &lhs, rec_vec const &rhs) {
+        return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](T const &a, T const &b) -> std::partial_ordering {
+            return a <=> b;
+        });
+    }
+
+private:
+    std::vector<T> m_values;
+};
+
+namespace layout {
+// Tag placed before the storage (default)
+struct tag_first {
+    template<typename Tag, typename Storage>
+    struct fields {
+        static constexpr std::size_t tag_size = sizeof(Tag);
+        static constexpr std::size_t tag_offset = 0;
+        static constexpr std::size_t storage_offset = (sizeof(Tag) + alignof(Storage) - 1) / alignof(Storage) * alignof(Storage);
+
+        constexpr Tag tag() const noexcept {
+            return m_tag;
+        }
+
+        constexpr void set_tag(Tag tag) noexcept {
+            m_tag = tag;
+        }
+
+        Tag m_tag;
+        Storage m_storage;
+    };
+};
+
+// Storage placed before the tag, so that the alternatives live at offset 0
+struct tag_last {
+    template<typename Tag, typename Storage>
+    struct fields {
+        static constexpr std::size_t tag_size = sizeof(Tag);
+        static constexpr std::size_t tag_offset = (sizeof(Storage) + alignof(Tag) - 1) / alignof(Tag) * alignof(Tag);
+        static constexpr std::size_t storage_offset = 0;
+
+        constexpr Tag tag() const noexcept {
+            return m_tag;
+        }
+
+        constexpr void set_tag(Tag tag) noexcept {
+            m_tag = tag;
+        }
+
+        Storage m_storage;
+        Tag m_tag;
+    };
+};
+}
+
+namespace detail {
+template<typename T>
+inline constexpr bool is_boxed_v = false;
+
+template<typename T>
+inline constexpr bool is_boxed_v<boxed<T>> = true;
+
+// Alternatives whose storage member is constructed from std::in_place and the arguments of create/emplace
+template<typename T>
+inline constexpr bool is_indirect_v = is_boxed_v<T>;
+
+template<typename T>
+inline constexpr bool is_indirect_v<rec<T>> = true;
+
+template<typename T>
+struct unboxed {
+    using type = T;
+};
+
+template<typename T>
+struct unboxed<boxed<T>> {
+    using type = T;
+};
+
+template<typename T>
+using unboxed_t = typename unboxed<T>::type;
+
+// T with the value category and constness of the object expression bound to an explicit object parameter of type Self &&
+template<typename Self, typename T>
+using forward_like_t = std::conditional_t<std::is_lvalue_reference_v<Self>,
+    std::conditional_t<std::is_const_v<std::remove_reference_t<Self>>, T const &, T &>,
+    std::conditional_t<std::is_const_v<std::remove_reference_t<Self>>, T const &&, T &&>>;
+
+// Reference to the alternative held in a storage member, with the value category of the member
+template<typename T>
+constexpr T &&unbox(T &&value) noexcept {
+    return std::forward<T>(value);
+}
+
+template<typename T>
+constexpr T &unbox(boxed<T> &value) noexcept {
+    return value.get();
+}
+
+template<typename T>
+constexpr T const &unbox(boxed<T> const &value) noexcept {
+    return value.get();
+}
+
+template<typename T>
+constexpr T &&unbox(boxed<T> &&value) noexcept {
+    return std::move(value.get());
+}
+
+template<typename T>
+constexpr T const &&unbox(boxed<T> const &&value) noexcept {
+    return std::move(value.get());
+}
+
+// Constructs the storage member of an alternative from the arguments of create/emplace
+template<typename Stored, typename... Args>
+constexpr void store(Stored *p, Args &&...args) {
+    if constexpr (is_indirect_v<Stored>) {
+        std::construct_at(p, std::in_place, std::forward<Args>(args)...);
+    } else {
+        std::construct_at(p, std::forward<Args>(args)...);
+    }
+}
+
+// Uses-allocator construction of the storage member of an alternative
+template<typename Stored, typename Allocator, typename... Args>
+constexpr void store_using_allocator(Stored *p, Allocator const &allocator, Args &&...args) {
+    if constexpr (is_boxed_v<Stored>) {
+        std::construct_at(p, std::allocator_arg, allocator, std::forward<Args>(args)...);
+    } else if constexpr (is_indirect_v<Stored>) {
+        store(p, std::forward<Args>(args)...);
+    } else {
+        std::uninitialized_construct_using_allocator(p, allocator, std::forward<Args>(args)...);
+    }
+}
+
+// Whether any alternative of Union uses Allocator
+template<typename Union, typename Allocator, typename = std::make_index_sequence<Union::alternative_count>>
+inline constexpr bool uses_allocator_v = false;
+
+template<typename Union, typename Allocator, std::size_t... index>
+inline constexpr bool uses_allocator_v<Union, Allocator, std::index_sequence<index...>> =
+    (std::uses_allocator_v<typename Union::template alternative_t<static_cast<typename Union::tag_t>(index)>, Allocator> || ...);
+
+// Boxes and nodes are allocated, so they may always throw
+template<typename Stored, typename... Args>
+inline constexpr bool is_nothrow_storable_v = !is_indirect_v<Stored> && std::is_nothrow_constructible_v<Stored, Args...>;
+
+struct niche_info {
+    bool empty;
+    std::size_t count;
+};
+
+// Index of the only non-empty alternative if its niches can encode all other alternatives, SIZE_MAX otherwise
+constexpr std::size_t find_niche_carrier(std::initializer_list<niche_info> alternatives) {
+    std::size_t carrier = SIZE_MAX;
+    std::size_t index = 0;
+    for (niche_info const &info : alternatives) {
+        if (!info.empty) {
+            if (carrier != SIZE_MAX) {
+                return SIZE_MAX;
+            }
+            carrier = index;
+        }
+        ++index;
+    }
+    return carrier != SIZE_MAX && std::data(alternatives)[carrier].count >= alternatives.size() - 1 ? carrier : SIZE_MAX;
+}
+
+// Encodes the tag in the invalid representations of the carrier alternative instead of a separate member
+template<typename Tag, typename Storage, std::size_t carrier, typename Carrier>
+struct niche_fields {
+    static constexpr std::size_t tag_size = 0;
+    static constexpr std::size_t tag_offset = 0;
+    static constexpr std::size_t storage_offset = 0;
+
+    constexpr Tag tag() const noexcept {
+        if constexpr (niche<Carrier>::count == 0) { // the carrier is the only alternative
+            return static_cast<Tag>(carrier);
+        } else {
+            std::size_t index = niche<Carrier>::load(std::addressof(m_storage));
+            if (index == niche<Carrier>::count) {
+                return static_cast<Tag>(carrier);
+            }
+            return static_cast<Tag>(index < carrier ? index : index + 1);
+        }
+    }
+
+    constexpr void set_tag(Tag tag) noexcept {
+        if constexpr (niche<Carrier>::count != 0) {
+            std::size_t index = static_cast<std::size_t>(tag);
+            if (index != carrier) {
+                niche<Carrier>::store(std::addressof(m_storage), index < carrier ? index : index - 1);
+            }
+        }
+    }
+
+    Storage m_storage;
+};
+
+// Condition of the static_assert in the last branch of an if constexpr chain, which must depend on a template parameter
+template<typename...>
+inline constexpr bool always_false_v = false;
+
+template<std::size_t N>
+using smallest_unsigned_t = std::conditional_t<(N <= UINT8_MAX + 1), std::uint8_t, std::conditional_t<(N <= UINT16_MAX + 1), std::uint16_t, std::uint32_t>>;
+
+template<typename T>
+inline constexpr bool is_trivially_copy_assignable_v = std::is_trivially_copy_constructible_v<T> && std::is_trivially_copy_assignable_v<T> && std::is_trivially_destructible_v<T>;
+
+template<typename T>
+inline constexpr bool is_trivially_move_assignable_v = std::is_trivially_move_constructible_v<T> && std::is_trivially_move_assignable_v<T> && std::is_trivially_destructible_v<T>;
+
+// Same-tag assignment forwards to the alternative's own operator= when it has one
+template<typename T>
+inline constexpr bool is_nothrow_copy_assignable_v = std::is_nothrow_copy_constructible_v<T> && (!std::is_copy_assignable_v<T> || std::is_nothrow_copy_assignable_v<T>);
+
+template<typename T>
+inline constexpr bool is_nothrow_move_assignable_v = std::is_nothrow_move_constructible_v<T> && (!std::is_move_assignable_v<T> || std::is_nothrow_move_assignable_v<T>);
+
+// Same-tag emplace assigns in place when the single argument implicitly converts to the alternative
+template<typename T, typename... Args>
+inline constexpr bool is_reassignable_v = false;
+
+template<typename T, typename Arg>
+inline constexpr bool is_reassignable_v<T, Arg> = std::is_convertible_v<Arg, T> && std::is_assignable_v<T &, Arg>;
+
+template<typename Stored, typename... Args>
+inline constexpr bool is_nothrow_emplaceable_v = is_nothrow_storable_v<Stored, Args...>;
+
+template<typename Stored, typename Arg>
+inline constexpr bool is_nothrow_emplaceable_v<Stored, Arg> = is_nothrow_storable_v<Stored, Arg> && (!is_reassignable_v<unboxed_t<Stored>, Arg> || std::is_nothrow_assignable_v<unboxed_t<Stored> &, Arg>);
+
+// std::construct_at that is only checked when instantiated, so that generated members can name non-copyable alternatives
+template<typename T, typename... Args>
+constexpr void construct(T *p, Args &&...args) {
+    std::construct_at(p, std::forward<Args>(args)...);
+}
+
+// Empty alternatives (e.g. `struct {}`) compare equal and hash to 0
+template<typename T>
+inline constexpr bool is_equality_comparable_v = std::is_empty_v<T> || requires(T const &value) { static_cast<bool>(value == value); };
+
+template<typename T>
+inline constexpr bool is_three_way_comparable_v = std::is_empty_v<T> || requires(T const &value) { value <=> value; };
+
+template<typename T>
+inline constexpr bool is_hashable_v = std::is_empty_v<T> || requires(T const &value) { std::hash<T>{}(value); };
+
+// Alternatives whose equality is equality of their object representations
+template<typename T>
+inline constexpr bool is_bitwise_comparable_v = (std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>) && std::has_unique_object_representations_v<T>;
+
+template<typename T>
+struct compare_result {
+    using type = std::strong_ordering;
+};
+
+template<typename T>
+    requires(!std::is_empty_v<T> && is_three_way_comparable_v<T>)
+struct compare_result<T> {
+    using type = decltype(std::declval<T const &>() <=> std::declval<T const &>());
+};
+
+// Comparison traits of all alternatives, only instantiated by the comparison operators so that the alternatives of
+// recursive unions (e.g. std::vector<Self>) are complete by then
+template<typename Union, typename = std::make_index_sequence<Union::alternative_count>>
+struct comparison_traits;
+
+template<typename Union, std::size_t... index>
+struct comparison_traits<Union, std::index_sequence<index...>> {
+    template<std::size_t i>
+    using alternative_t = typename Union::template alternative_t<static_cast<typename Union::tag_t>(i)>;
+
+    template<std::size_t i>
+    using stored_t = typename Union::template stored_t<static_cast<typename Union::tag_t>(i)>;
+
+    static constexpr bool equality_comparable = (is_equality_comparable_v<alternative_t<index>> && ...);
+    static constexpr bool three_way_comparable = (is_three_way_comparable_v<alternative_t<index>> && ...);
+    static constexpr bool hashable = (is_hashable_v<alternative_t<index>> && ...);
+    static constexpr bool bitwise_comparable = (is_bitwise_comparable_v<stored_t<index>> && ...);
+};
+
+template<typename Union, typename = std::make_index_sequence<Union::alternative_count>>
+struct comparison_category;
+
+template<typename Union, std::size_t... index>
+struct comparison_category<Union, std::index_sequence<index...>> {
+    using type = std::common_comparison_category_t<typename compare_result<typename Union::template alternative_t<static_cast<typename Union::tag_t>(index)>>::type..., std::strong_ordering>;
+};
+
+template<typename T>
+constexpr bool equal(T const &lhs, T const &rhs) {
+    if constexpr (std::is_empty_v<T>) {
+        return true;
+    } else {
+        return static_cast<bool>(lhs == rhs);
+    }
+}
+
+template<typename T>
+constexpr typename compare_result<T>::type compare(T const &lhs, T const &rhs) {
+    if constexpr (std::is_empty_v<T>) {
+        return std::strong_ordering::equal;
+    } else {
+        return lhs <=> rhs;
+    }
 }
+
+template<typename T>
+std::size_t hash(T const &value) noexcept {
+    if constexpr (std::is_empty_v<T>) {
+        return 0;
+    } else {
+        return std::hash<T>{}(value);
+    }
+}
+
+constexpr std::size_t hash_combine(std::size_t seed, std::size_t value) noexcept {
+    return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+}
+
+// Word-wise hash of an object representation without padding
+inline std::size_t hash_bytes(void const *data, std::size_t size) noexcept {
+    auto const *bytes = static_cast<unsigned char const *>(data);
+    std::uint64_t hash = size;
+    for (std::size_t i = 0; i < size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes + i, std::min(sizeof(word), size - i));
+        hash = (hash ^ word) * 0x9e3779b97f4a7c15;
+        hash ^= hash >> 32;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+// std::tuple of one Column<alternative_t<tag>> per alternative, in tag order
+template<typename Union, template<typename...> typename Column, typename = std::make_index_sequence<Union::alternative_count>>
+struct alternative_columns;
+
+template<typename Union, template<typename...> typename Column, std::size_t... index>
+struct alternative_columns<Union, Column, std::index_sequence<index...>> {
+    using type = std::tuple<Column<typename Union::template alternative_t<static_cast<typename Union::tag_t>(index)>>...>;
+};
+
+// Calls f(tu::in_place_tag<tag>) for a tag only known at runtime through a table, all calls must return the same type
+template<typename Union, typename F, std::size_t... index>
+decltype(auto) dispatch_tag(typename Union::tag_t tag, F &&f, std::index_sequence<index...>) {
+    using tag_t = typename Union::tag_t;
+    using R = decltype(std::forward<F>(f)(tu::in_place_tag<tag_t(0)>));
+    static constexpr R (*table[])(F &&) = {[](F &&f) -> R { return std::forward<F>(f)(tu::in_place_tag<static_cast<tag_t>(index)>); }...};
+    return table[static_cast<std::size_t>(tag)](std::forward<F>(f));
+}
+
+template<typename Union, typename F>
+decltype(auto) dispatch_tag(typename Union::tag_t tag, F &&f) {
+    return dispatch_tag<Union>(tag, std::forward<F>(f), std::make_index_sequence<Union::alternative_count>{});
+}
+
+// The extra parameters make the check dependent, so that visit and match look for the profile where they are
+// instantiated, after it has been declared
+template<typename Union, typename...>
+inline constexpr bool is_profiled_v = requires { dispatch_profile<Union>::frequencies; };
+
+template<typename Union>
+struct profile_layout {
+    static constexpr std::size_t count = Union::alternative_count;
+    static constexpr auto const &frequencies = dispatch_profile<Union>::frequencies;
+    // At most this many alternatives are tested with branches before the switch, see UNION_PROFILED_CHECKS
+    static constexpr std::size_t max_checks = 4;
+
+    static constexpr std::uint64_t total = [] {
+        std::uint64_t sum = 0;
+        for (std::uint64_t frequency : frequencies) {
+            sum += frequency;
+        }
+        return sum;
+    }();
+
+    // A profile without visits says nothing, so it keeps the unprofiled layout: no arm is cold and none is checked first
+    static constexpr bool cold(std::size_t tag) noexcept {
+        return total != 0 && (frequencies[tag] < total / 100 || frequencies[tag] == 0);
+    }
+
+    // Tags by decreasing frequency
+    static constexpr std::array<std::size_t, count> order = [] {
+        std::array<std::size_t, count> tags;
+        for (std::size_t tag = 0; tag < count; ++tag) {
+            tags[tag] = tag;
+        }
+        std::sort(tags.begin(), tags.end(), [](std::size_t a, std::size_t b) {
+            return frequencies[a] != frequencies[b] ? frequencies[a] > frequencies[b] : a < b;
+        });
+        return tags;
+    }();
+
+    // An alternative is tested with a branch while it takes at least half of the visits that reach the branch
+    static constexpr std::size_t checks = [] {
+        std::size_t n = 0;
+        std::uint64_t remaining = total;
+        while (total != 0 && n < std::min(count, max_checks) && !cold(order[n]) && frequencies[order[n]] * 2 >= remaining) {
+            remaining -= frequencies[order[n++]];
+        }
+        return n;
+    }();
+};
+
+// Number of alternatives that visit and match test with a branch before their switch
+template<typename Union, typename... Dependent>
+constexpr std::size_t profile_checks() noexcept {
+    if constexpr (is_profiled_v<Union, Dependent...>) {
+        return profile_layout<Union>::checks;
+    } else {
+        return 0;
+    }
+}
+
+template<typename Union, std::size_t check, typename... Dependent>
+inline constexpr auto profile_check_v = static_cast<typename Union::tag_t>(profile_layout<Union>::order[check]);
+
+// Whether visit and match call the arm of tag out of line
+template<typename Union, typename... Dependent>
+constexpr bool is_cold(typename Union::tag_t tag) noexcept {
+    if constexpr (is_profiled_v<Union, Dependent...>) {
+        return profile_layout<Union>::cold(static_cast<std::size_t>(tag));
+    } else {
+        return false;
+    }
+}
+
+template<typename ReturnType, typename Arm>
+TU_COLD constexpr ReturnType cold_call(Arm &&arm) {
+    return std::forward<Arm>(arm)();
+}
+
+struct match_otherwise_t {};
+
+inline constexpr match_otherwise_t match_otherwise;
+
+// Result of the block of a MATCH_SWITCH arm, run as arm
+template<typename ReturnType, typename Arm>
+constexpr ReturnType match_switch_arm(Arm &&arm) {
+    static_assert(std::is_void_v<ReturnType> || !std::is_void_v<std::invoke_result_t<Arm>>, "MATCH_SWITCH: an arm does not return a value");
+    return std::forward<Arm>(arm)();
+}
+
+// Alternatives handled by the arms of a MATCH_SWITCH, accumulated with | over its CASE tags and OTHERWISE
+template<typename Union>
+struct match_coverage {
+    std::array<bool, Union::alternative_count> cases{};
+    bool otherwise = false;
+
+    constexpr match_coverage operator|(typename Union::tag_t tag) const {
+        match_coverage result = *this;
+        result.cases[static_cast<std::size_t>(tag)] = true;
+        return result;
+    }
+
+    constexpr match_coverage operator|(match_otherwise_t) const {
+        match_coverage result = *this;
+        result.otherwise = true;
+        return result;
+    }
+
+    constexpr bool exhaustive() const {
+        return otherwise || std::all_of(cases.begin(), cases.end(), [](bool covered) { return covered; });
+    }
+};
+
+// Dispatch over several unions through one flattened table indexed by the combined tag
+template<typename ReturnType, typename Visitor, typename... Unions>
+struct multi_visit {
+    static constexpr std::size_t counts[] = {std::remove_cvref_t<Unions>::alternative_count...};
+    static constexpr std::size_t total = (std::size_t(1) * ... * std::remove_cvref_t<Unions>::alternative_count);
+
+    // Underlying value of the tag of the at-th union in the combination with index flat
+    static constexpr std::size_t digit(std::size_t flat, std::size_t at) {
+        for (std::size_t i = sizeof...(Unions); --i > at;) {
+            flat /= counts[i];
+        }
+        return flat % counts[at];
+    }
+
+    static constexpr std::size_t index(typename std::remove_cvref_t<Unions>::tag_t... tags) noexcept {
+        std::size_t flat = 0;
+        ((flat = flat * std::remove_cvref_t<Unions>::alternative_count + static_cast<std::size_t>(tags)), ...);
+        return flat;
+    }
+
+    template<std::size_t flat, std::size_t... at>
+    static constexpr ReturnType arm(std::index_sequence<at...>, Visitor &&visitor, Unions &&...unions) {
+        if constexpr (requires { std::forward<Visitor>(visitor)(tu::in_place_tag<static_cast<typename std::remove_cvref_t<Unions>::tag_t>(digit(flat, at))>..., std::forward<Unions>(unions).template get_ref<static_cast<typename std::remove_cvref_t<Unions>::tag_t>(digit(flat, at))>()...); }) {
+            return std::forward<Visitor>(visitor)(tu::in_place_tag<static_cast<typename std::remove_cvref_t<Unions>::tag_t>(digit(flat, at))>..., std::forward<Unions>(unions).template get_ref<static_cast<typename std::remove_cvref_t<Unions>::tag_t>(digit(flat, at))>()...);
+        } else if constexpr (requires { std::forward<Visitor>(visitor)(std::forward<Unions>(unions)...); }) {
+            return std::forward<Visitor>(visitor)(std::forward<Unions>(unions)...);
+        } else {
+            static_assert(always_false_v<Visitor>, "tu::visit: the visitor accepts neither this combination of alternatives nor the unions");
+        }
+    }
+
+    template<std::size_t flat>
+    static constexpr ReturnType entry(Visitor &&visitor, Unions &&...unions) {
+        return arm<flat>(std::index_sequence_for<Unions...>{}, std::forward<Visitor>(visitor), std::forward<Unions>(unions)...);
+    }
+
+    template<std::size_t... flat>
+    static constexpr auto make_table(std::index_sequence<flat...>) noexcept {
+        return std::array<ReturnType (*)(Visitor &&, Unions &&...), total>{&entry<flat>...};
+    }
+
+    static constexpr auto table = make_table(std::make_index_sequence<total>{});
+};
+}
+
+#if defined(TU_INSTRUMENT)
+namespace detail {
+// Per-thread counters of a union. Every thread increments its own counters with relaxed loads and stores, and
+// registers them on first use so that stats() can sum them; counters of finished threads are kept in retired.
+template<typename Union>
+struct instrumentation {
+public:
+    using tag_t = typename Union::tag_t;
+
+    static constexpr std::size_t count = Union::alternative_count;
+
+    static constexpr void record_visit(tag_t tag) noexcept {
+        if (!std::is_constant_evaluated()) {
+            increment(local().m_visits[static_cast<std::size_t>(tag)]);
+        }
+    }
+
+    static constexpr void record_transition(tag_t from, tag_t to) noexcept {
+        if (!std::is_constant_evaluated()) {
+            increment(local().m_transitions[static_cast<std::size_t>(from) * count + static_cast<std::size_t>(to)]);
+        }
+    }
+
+    static union_stats<count> snapshot() {
+        registry &r = global();
+        std::lock_guard lock(r.m_mutex);
+        union_stats<count> stats = r.m_retired;
+        for (counters const *c : r.m_threads) {
+            c->add_to(stats);
+        }
+        return stats;
+    }
+
+private:
+    struct counters {
+        void add_to(union_stats<count> &stats) const noexcept {
+            for (std::size_t from = 0; from < count; ++from) {
+                stats.visits[from] += m_visits[from].load(std::memory_order_relaxed);
+                for (std::size_t to = 0; to < count; ++to) {
+                    stats.transitions[from][to] += m_transitions[from * count + to].load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        std::array<std::atomic<std::uint64_t>, count> m_visits{};
+        std::array<std::atomic<std::uint64_t>, count * count> m_transitions{};
+    };
+
+    struct registry {
+        std::mutex m_mutex;
+        std::vector<counters const *> m_threads;
+        union_stats<count> m_retired;
+    };
+
+    struct thread_counters : counters {
+        thread_counters() {
+            registry &r = global();
+            std::lock_guard lock(r.m_mutex);
+            r.m_threads.push_back(this);
+        }
+
+        ~thread_counters() {
+            registry &r = global();
+            std::lock_guard lock(r.m_mutex);
+            this->add_to(r.m_retired);
+            std::erase(r.m_threads, this);
+        }
+    };
+
+    // Constructed by the first thread_counters, so that it outlives the counters of every thread
+    static registry &global() {
+        static registry r;
+        return r;
+    }
+
+    static counters &local() {
+        static thread_local thread_counters c;
+        return c;
+    }
+
+    // Only the owning thread writes its counters, so a load and a store suffice and no locked instruction is needed
+    static void increment(std::atomic<std::uint64_t> &counter) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+}
+
+// Source of a tu::dispatch_profile specialization holding the visit counts of Union so far, to be written to a
+// header that is included after the union in the next build
+template<typename Union>
+std::string dispatch_profile_source(std::string_view union_name) {
+    std::string name(union_name);
+    std::string source = "template<>\nstruct tu::dispatch_profile<" + name + "> {\n    static constexpr std::array<std::uint64_t, " + name + "::alternative_count> frequencies = {";
+    auto stats = Union::stats();
+    for (std::size_t tag = 0; tag < Union::alternative_count; ++tag) {
+        source += (tag == 0 ? "" : ", ") + std::to_string(stats.visits[tag]);
+    }
+    return source + "};\n};\n";
+}
+#endif
+
+// Visit several unions at once, the visitor is called with the tags of all unions followed by their alternatives,
+// or with the unions themselves if no such overload exists
+template<typename ReturnType, typename Visitor, typename... Unions>
+constexpr ReturnType visit(Visitor &&visitor, Unions &&...unions) {
+    using dispatch = detail::multi_visit<ReturnType, Visitor, Unions...>;
+    return dispatch::table[dispatch::index(unions.get_tag()...)](std::forward<Visitor>(visitor), std::forward<Unions>(unions)...);
+}
+}
+
+template<typename Union>
+    requires requires(Union const &value) {
+        typename Union::tag_t;
+        Union::alternative_count;
+        value.hash_value();
+    }
+struct std::hash<Union> {
+    std::size_t operator()(Union const &value) const noexcept {
+        return value.hash_value();
+    }
+};
+
+// Unions are allocator-aware like std::tuple: the allocator is not stored, but passed on to the alternative
+template<typename Union, typename Allocator>
+    requires requires {
+        typename Union::tag_t;
+        Union::alternative_count;
+    } && tu::detail::uses_allocator_v<Union, Allocator>
+struct std::uses_allocator<Union, Allocator> : std::true_type {};
+
+template<typename T>
+struct std::hash<tu::rec<T>> {
+    std::size_t operator()(tu::rec<T> const &value) const {
+        return std::hash<T>{}(*value);
+    }
+};
+
+template<typename T>
+struct std::hash<tu::rec_vec<T>> {
+    std::size_t operator()(tu::rec_vec<T> const &values) const {
+        std::size_t seed = values.size();
+        for (T const &value : values) {
+            seed = tu::detail::hash_combine(seed, std::hash<T>{}(value));
+        }
+        return seed;
+    }
+};
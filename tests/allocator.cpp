@@ -0,0 +1,75 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+UNION(Value
+    , (std::pmr::string, name)
+    , (int, id)
+    , (BOXED(std::pmr::vector<int>), list)
+);
+
+UNION(Plain
+    , (int, a)
+    , (double, b)
+);
+
+static_assert(std::uses_allocator_v<Value, std::pmr::polymorphic_allocator<char>>);
+static_assert(!std::uses_allocator_v<Value, std::allocator<char>>);
+static_assert(!std::uses_allocator_v<Plain, std::pmr::polymorphic_allocator<char>>);
+
+int main() {
+    // Anything allocated without the arena's allocator fails
+    std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    static std::byte buffer[16384];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    std::pmr::polymorphic_allocator<char> allocator(&arena);
+    char const *text = "a string long enough not to fit in the small string buffer";
+
+    Value name = Value::create_name(std::allocator_arg, allocator, text);
+    CHECK(name.get_name_ref() == text);
+    CHECK(name.get_name_ref().get_allocator().resource() == &arena);
+
+    // Alternatives that are not allocator-aware ignore the allocator
+    Value id = Value::create<Value::tag_t::id>(std::allocator_arg, allocator, 3);
+    CHECK(id.get_id_ref() == 3);
+    id.emplace_name(std::allocator_arg, allocator, 64, 'x');
+    CHECK(id.get_name_ref() == std::pmr::string(64, 'x', allocator));
+    CHECK(id.get_name_ref().get_allocator().resource() == &arena);
+    Plain plain(std::allocator_arg, allocator, Plain::create_a(1));
+    CHECK(plain.get_a_ref() == 1);
+
+    // Allocator-extended copy and move
+    Value copy(std::allocator_arg, allocator, name);
+    CHECK(copy.get_name_ref() == text);
+    CHECK(copy.get_name_ref().get_allocator().resource() == &arena);
+    Value moved(std::allocator_arg, allocator, std::move(copy));
+    CHECK(moved.get_name_ref() == text);
+    CHECK(moved.get_name_ref().get_allocator().resource() == &arena);
+
+    // Allocator-aware containers propagate their allocator into the elements
+    std::pmr::vector<Value> values(&arena);
+    values.reserve(4);
+    values.push_back(name);
+    values.emplace_back(Value::create_id(1));
+    values.emplace_back(std::move(moved));
+    CHECK(values[0].get_name_ref().get_allocator().resource() == &arena);
+    CHECK(values[2].get_name_ref() == text);
+
+    // The box comes from tu::box_allocator, the boxed value from the allocator
+    std::pmr::set_default_resource(std::pmr::new_delete_resource());
+    Value list = Value::create_list(std::allocator_arg, allocator, std::initializer_list<int>{1, 2, 3});
+    CHECK(list.get_list_ref().size() == 3);
+    CHECK(list.get_list_ref().get_allocator().resource() == &arena);
+    Value list_copy(std::allocator_arg, allocator, list);
+    CHECK(list_copy.get_list_ref()[2] == 3);
+    CHECK(list_copy.get_list_ref().get_allocator().resource() == &arena);
+
+    // The null resource throws when used
+    std::pmr::monotonic_buffer_resource full(std::pmr::null_memory_resource());
+    CHECK_THROWS(std::bad_alloc, Value::create_name(std::allocator_arg, std::pmr::polymorphic_allocator<char>(&full), text));
+    return 0;
+}
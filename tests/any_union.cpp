@@ -0,0 +1,156 @@
+#include "any_union.hpp"
+
+#include "check.hpp"
+
+#include <memory>
+#include <string>
+
+#if defined(TU_TEST_PLUGINS)
+#include <dlfcn.h>
+#endif
+
+namespace app {
+UNION(Msg
+    , (int, id)
+    , (std::string, text)
+);
+}
+
+namespace other {
+UNION(Msg
+    , (int, id)
+    , (std::string, text)
+);
+}
+
+// Same names, sizes and alignments as app::Msg, different alternative types
+namespace confused {
+UNION(Msg
+    , (float, id)
+    , (std::string, text)
+);
+}
+
+struct Opaque {
+    int value;
+};
+
+// Neither hashable nor copyable
+UNION(Unhashable
+    , (Opaque, opaque)
+    , (std::unique_ptr<int>, owned)
+);
+
+UNION(Tree
+    , (int, leaf)
+    , (BOXED(std::string), label)
+    , (tu::rec<Tree>, child)
+);
+
+static_assert(app::Msg::field_types[0] == "int" && app::Msg::field_types[1] == "std::string");
+
+void test_descriptor() {
+    tu_union_descriptor const &descriptor = tu::descriptor_v<app::Msg>;
+    CHECK(descriptor.version == TU_UNION_DESCRIPTOR_VERSION);
+    CHECK(std::string_view(descriptor.name) == "Msg");
+    CHECK(std::string_view(descriptor.qualified_name) == "app::Msg");
+    CHECK(std::string_view(descriptor.alternative_types[0].spelling) == "int");
+    CHECK(std::string_view(descriptor.alternative_types[0].name) == "int");
+    CHECK(std::string_view(descriptor.alternative_types[1].spelling) == "std::string");
+
+    app::Msg msg = app::Msg::create_text("hello");
+    tu::any_union value(msg);
+    CHECK(value.name() == "Msg" && value.tag() == 1 && value.tag_name() == "text");
+    CHECK(*static_cast<std::string *>(value.alternative()) == "hello");
+    CHECK(value.get_if<app::Msg>() == &msg);
+    CHECK(value.hash() == std::hash<app::Msg>{}(msg));
+
+    // Same unqualified name and layout, but a different union or different alternative types
+    CHECK(value.get_if<other::Msg>() == nullptr);
+    CHECK(value.get_if<confused::Msg>() == nullptr);
+
+    // Boxed alternatives are passed as the boxed value, recursive ones as the tu::rec
+    Tree label = Tree::create_label("boxed");
+    CHECK(*static_cast<std::string *>(tu::any_union(label).alternative()) == "boxed");
+    CHECK(std::string_view(tu::descriptor_v<Tree>.alternative_types[1].spelling) == "tu::boxed<std::string>");
+    Tree child = Tree::create_child(Tree::create_leaf(7));
+    auto *rec = static_cast<tu::rec<Tree> *>(tu::any_union(child).alternative());
+    CHECK(rec == &child.get_child_ref() && (*rec)->get_leaf_ref() == 7);
+    CHECK(std::string_view(tu::descriptor_v<Tree>.alternative_types[2].spelling) == "tu::rec<Tree>");
+
+    Unhashable unhashable = Unhashable::create_opaque(Opaque{1});
+    CHECK(tu::descriptor_v<Unhashable>.hash == nullptr && tu::descriptor_v<Unhashable>.copy_construct == nullptr);
+    CHECK(!tu::any_union(unhashable).hash().has_value());
+}
+
+void test_versions() {
+    // A copy, as a library built against the same header would have it
+    tu_union_descriptor copy = tu::descriptor_v<app::Msg>;
+    CHECK(tu::compatible(copy, tu::descriptor_v<app::Msg>));
+
+    // A version 1 descriptor has no qualified name or alternative types, so only the fields of version 1 are compared
+    tu_union_descriptor old = tu::descriptor_v<confused::Msg>;
+    old.version = 1;
+    old.qualified_name = nullptr;
+    old.alternative_types = nullptr;
+    CHECK(tu::compatible(old, tu::descriptor_v<app::Msg>) && tu::compatible(tu::descriptor_v<app::Msg>, old));
+    CHECK(!tu::compatible(tu::descriptor_v<confused::Msg>, tu::descriptor_v<app::Msg>));
+
+    // Later versions are compared on the fields this version knows
+    tu_union_descriptor newer = tu::descriptor_v<app::Msg>;
+    newer.version = TU_UNION_DESCRIPTOR_VERSION + 1;
+    CHECK(tu::compatible(newer, tu::descriptor_v<app::Msg>));
+
+    tu_union_descriptor invalid = tu::descriptor_v<app::Msg>;
+    invalid.version = 0;
+    CHECK(!tu::compatible(invalid, tu::descriptor_v<app::Msg>));
+    copy.alternatives = tu::descriptor_v<other::Msg>.alternatives;
+    copy.size += 8;
+    CHECK(!tu::compatible(copy, tu::descriptor_v<app::Msg>));
+}
+
+void test_dispatch() {
+    tu::any_dispatch<int> dispatch(+[](void *) { return -1; });
+    dispatch.on("text", +[](void *text) { return static_cast<int>(static_cast<std::string *>(text)->size()); });
+    app::Msg text = app::Msg::create_text("four");
+    app::Msg id = app::Msg::create_id(7);
+    CHECK(dispatch(tu::any_union(text)) == 4);
+    CHECK(dispatch(tu::any_union(id)) == -1);
+    other::Msg second = other::Msg::create_text("seven..");
+    CHECK(dispatch(tu::any_union(second)) == 7);
+}
+
+#if defined(TU_TEST_PLUGINS)
+// Loads a plugin built from any_union_plugin.cpp with hidden visibility, so that it has a descriptor_v of its own
+void test_plugin(char const *path, bool confused) {
+    void *library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    CHECK(library != nullptr);
+    auto handle = reinterpret_cast<int (*)(tu_any_union)>(dlsym(library, "plugin_handle"));
+    auto descriptor = reinterpret_cast<tu_union_descriptor const *(*)()>(dlsym(library, "plugin_descriptor"));
+    CHECK(handle != nullptr && descriptor != nullptr);
+    CHECK(descriptor() != &tu::descriptor_v<app::Msg>);
+    CHECK(tu::compatible(*descriptor(), tu::descriptor_v<app::Msg>) == !confused);
+
+    app::Msg text = app::Msg::create_text("abcd");
+    app::Msg id = app::Msg::create_id(42);
+    CHECK(handle(tu::any_union(text).handle()) == (confused ? -1 : 4));
+    CHECK(handle(tu::any_union(id).handle()) == (confused ? -1 : 42));
+    dlclose(library);
+}
+#endif
+
+int main(int argc, char **argv) {
+    test_descriptor();
+    test_versions();
+    test_dispatch();
+#if defined(TU_TEST_PLUGINS)
+    // Passed by the any_union_plugins test
+    if (argc == 3) {
+        test_plugin(argv[1], false);
+        test_plugin(argv[2], true);
+    }
+#else
+    (void)argc;
+    (void)argv;
+#endif
+}
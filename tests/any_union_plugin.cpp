@@ -0,0 +1,33 @@
+#include "any_union.hpp"
+
+#include <string>
+
+// Built as two modules: one with the host's definition of Msg, and one where TU_PLUGIN_CONFUSED swaps the type of id for
+// another of the same size and alignment, which only the alternative types in the descriptor tell apart
+namespace app {
+#if defined(TU_PLUGIN_CONFUSED)
+UNION(Msg
+    , (float, id)
+    , (std::string, text)
+);
+#else
+UNION(Msg
+    , (int, id)
+    , (std::string, text)
+);
+#endif
+}
+
+// The id or the length of the text of a Msg, or -1 if the union is not a Msg as defined here
+extern "C" __attribute__((visibility("default"))) int plugin_handle(tu_any_union handle) {
+    if (app::Msg *msg = tu::any_union(handle).get_if<app::Msg>()) {
+        return MATCH_SWITCH(int, *msg
+            , CASE(id, id, { return static_cast<int>(id); })
+            , CASE(text, text, { return static_cast<int>(text.size()); }));
+    }
+    return -1;
+}
+
+extern "C" __attribute__((visibility("default"))) tu_union_descriptor const *plugin_descriptor() {
+    return &tu::descriptor_v<app::Msg>;
+}
@@ -0,0 +1,119 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <string>
+#include <vector>
+
+UNION(MyUnion
+    , (int, index)
+    , (std::string, name)
+);
+
+// Counts copies and moves, and has a nothrow move only if Nothrow
+template<bool Nothrow>
+struct Tracked {
+    Tracked() = default;
+    Tracked(Tracked const &) { ++copies; }
+    Tracked(Tracked &&) noexcept(Nothrow) { ++moves; }
+    Tracked &operator=(Tracked const &) = default;
+    Tracked &operator=(Tracked &&) noexcept(Nothrow) = default;
+
+    static inline int copies = 0;
+    static inline int moves = 0;
+};
+
+UNION(NothrowMove
+    , (int, index)
+    , (Tracked<true>, tracked)
+);
+
+UNION(ThrowingMove
+    , (int, index)
+    , (Tracked<false>, tracked)
+);
+
+// Assignment from int that returns nothing
+struct Setting {
+    Setting(int v) : value(v) {}
+    void operator=(int v) { value = v; ++assignments; }
+
+    int value;
+    static inline int assignments = 0;
+};
+
+UNION(Config
+    , (Setting, setting)
+    , (std::string, name)
+);
+
+static_assert(std::is_nothrow_move_constructible_v<MyUnion>);
+static_assert(std::is_nothrow_move_assignable_v<MyUnion>);
+static_assert(!std::is_nothrow_copy_constructible_v<MyUnion>);
+static_assert(!std::is_nothrow_copy_assignable_v<MyUnion>);
+static_assert(std::is_nothrow_move_constructible_v<NothrowMove>);
+static_assert(!std::is_nothrow_move_constructible_v<ThrowingMove>);
+static_assert(!std::is_nothrow_move_assignable_v<ThrowingMove>);
+static_assert(noexcept(MyUnion::create_index(1)));
+static_assert(!noexcept(MyUnion::create_name("x")));
+static_assert(noexcept(std::declval<MyUnion &>().emplace_index(1)));
+static_assert(!noexcept(std::declval<MyUnion &>().emplace_name("x")));
+
+int main() {
+    {
+        // Same alternative: the string is assigned and keeps its buffer
+        MyUnion a = MyUnion::create_name(std::string(100, 'a'));
+        MyUnion b = MyUnion::create_name("short");
+        char const *buffer = a.get_name_ref().data();
+        a = b;
+        CHECK(a.get_name_ref() == "short");
+        CHECK(a.get_name_ref().data() == buffer);
+        a = std::move(b);
+        CHECK(a.get_name_ref() == "short");
+    }
+    {
+        // Different alternatives are reconstructed
+        MyUnion a = MyUnion::create_index(1);
+        MyUnion b = MyUnion::create_name("name");
+        a = b;
+        CHECK(a.holds_name() && a.get_name_ref() == "name");
+        a = MyUnion::create_index(2);
+        CHECK(a.holds_index() && a.get_index_ref() == 2);
+        a = a;
+        CHECK(a.holds_index() && a.get_index_ref() == 2);
+    }
+    {
+        // emplace with one convertible argument assigns in place, with several reconstructs
+        MyUnion u = MyUnion::create_name(std::string(100, 'a'));
+        char const *buffer = u.get_name_ref().data();
+        u.emplace_name("x");
+        CHECK(u.get_name_ref() == "x");
+        CHECK(u.get_name_ref().data() == buffer);
+        u.emplace_name(std::size_t(3), 'y');
+        CHECK(u.get_name_ref() == "yyy");
+        std::string &name = u.emplace_name(std::string("z"));
+        CHECK(&name == &u.get_name_ref());
+        u.emplace_index(4);
+        CHECK(u.holds_index() && u.get_index_ref() == 4);
+    }
+    {
+        Config c = Config::create_setting(1);
+        Setting::assignments = 0;
+        Setting &setting = c.emplace_setting(2);
+        CHECK(Setting::assignments == 1);
+        CHECK(&setting == &c.get_setting_ref());
+        CHECK(setting.value == 2);
+    }
+    {
+        // std::vector moves elements with a nothrow move on reallocation, and copies the others
+        std::vector<NothrowMove> moved;
+        std::vector<ThrowingMove> copied;
+        for (int i = 0; i < 100; ++i) {
+            moved.push_back(NothrowMove::create_tracked());
+            copied.push_back(ThrowingMove::create_tracked());
+        }
+        CHECK(Tracked<true>::copies == 0);
+        CHECK(Tracked<false>::copies > 0);
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "atomic.hpp"
+
+#include "check.hpp"
+
+#include <thread>
+#include <vector>
+
+UNION(State
+    , (struct {}, idle)
+    , (std::uint32_t, running)
+    , (std::uint8_t, failed)
+);
+
+UNION(Wide
+    , (std::uint64_t, count)
+    , (double, ratio)
+);
+
+using Words = std::array<std::uint64_t, 4>;
+
+UNION(Large
+    , (Words, words)
+    , (std::uint32_t, small)
+);
+
+struct Padded {
+    char c;
+    int i;
+};
+
+UNION(Leftover
+    , (Padded, padded)
+    , (char, c)
+);
+
+// Increments the value from several threads with compare_exchange_weak loops
+template<typename Union, typename Next>
+void increment(tu::atomic<Union> &value, Next next, int threads, int iterations) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < iterations; ++i) {
+                Union expected = value.load();
+                while (!value.compare_exchange_weak(expected, next(expected))) {
+                }
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+int main() {
+    static_assert(tu::atomic<State>::is_always_lock_free);
+    static_assert(!tu::atomic<Large>::is_always_lock_free);
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+    static_assert(tu::atomic<Wide>::is_always_lock_free);
+#endif
+
+    tu::atomic<State> state(State::create_idle());
+    CHECK(state.load().holds_idle());
+    State expected = State::create_running(1);
+    CHECK(!state.compare_exchange_strong(expected, State::create_failed(1)));
+    CHECK(expected.holds_idle());
+    CHECK(state.compare_exchange_strong(expected, State::create_running(0)));
+    increment(state, [](State s) { return State::create_running(s.get_running_ref() + 1); }, 4, 20000);
+    CHECK(state.load().get_running_ref() == 80000);
+    CHECK(state.exchange(State::create_failed(3)).get_running_ref() == 80000);
+    // Same payload, different tag
+    expected = State::create_running(3);
+    CHECK(!state.compare_exchange_strong(expected, State::create_idle()));
+    CHECK(expected.get_failed_ref() == 3);
+    CHECK(state.compare_exchange_strong(expected, State::create_idle()));
+    state.store(State::create_running(7));
+    CHECK(state.load().get_running_ref() == 7);
+
+    tu::atomic<Wide> wide(Wide::create_count(0));
+    increment(wide, [](Wide w) { return Wide::create_count(w.get_count_ref() + 1); }, 4, 20000);
+    CHECK(wide.load().get_count_ref() == 80000);
+    Wide ratio = Wide::create_ratio(0.5);
+    CHECK(wide.exchange(ratio).get_count_ref() == 80000);
+    CHECK(wide.compare_exchange_strong(ratio, Wide::create_count(1)));
+
+    // Readers never observe a torn value of the sequence lock
+    tu::atomic<Large> large(Large::create_words(Words{}));
+    std::atomic<bool> stop{false};
+    std::atomic<bool> torn{false};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i) {
+        readers.emplace_back([&] {
+            while (!stop) {
+                Words words = large.load().get_words_ref();
+                if (words[0] != words[1] || words[1] != words[2] || words[2] != words[3]) {
+                    torn = true;
+                }
+            }
+        });
+    }
+    increment(large, [](Large l) {
+        Words words = l.get_words_ref();
+        for (auto &word : words) {
+            ++word;
+        }
+        return Large::create_words(words);
+    }, 3, 20000);
+    stop = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    CHECK(!torn);
+    CHECK(large.load().get_words_ref()[3] == 60000);
+    large.store(Large::create_small(1));
+    Large small = Large::create_small(1);
+    CHECK(large.compare_exchange_strong(small, Large::create_small(2)));
+    CHECK(large.load().get_small_ref() == 2);
+
+    // Padding and bytes left over from a larger alternative don't make compare_exchange fail
+    Leftover raw = Leftover::create_padded(Padded{'a', -1});
+    std::memset(static_cast<void *>(&raw), 0xff, sizeof(raw));
+    raw.emplace_c('x');
+    tu::atomic<Leftover> leftover(raw);
+    Leftover c = Leftover::create_c('x');
+    CHECK(leftover.compare_exchange_strong(c, Leftover::create_padded(Padded{'a', 1})));
+    Leftover padded = Leftover::create_padded(Padded{'a', 1});
+    CHECK(leftover.compare_exchange_strong(padded, Leftover::create_c('y')));
+    CHECK(leftover.load().get_c_ref() == 'y');
+    return 0;
+}
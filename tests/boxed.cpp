@@ -0,0 +1,153 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+struct Big {
+    char data[256];
+    int id;
+};
+
+// Allocator that counts the live boxes it allocated
+inline int live_boxes = 0;
+
+template<typename T>
+struct counting_allocator {
+    using value_type = T;
+
+    counting_allocator() = default;
+
+    template<typename U>
+    counting_allocator(counting_allocator<U> const &) noexcept {}
+
+    T *allocate(std::size_t count) {
+        ++live_boxes;
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T *pointer, std::size_t count) noexcept {
+        --live_boxes;
+        std::allocator<T>().deallocate(pointer, count);
+    }
+
+    friend bool operator==(counting_allocator, counting_allocator) noexcept {
+        return true;
+    }
+};
+
+struct Pooled {
+    explicit Pooled(std::string text) : text(std::move(text)) {}
+
+    Pooled(Pooled const &other) : text(other.text), fail(other.fail) {
+        if (fail) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+
+    Pooled &operator=(Pooled const &) = default;
+
+    std::string text;
+    bool fail = false;
+};
+
+template<>
+struct tu::box_allocator<Pooled> {
+    using type = counting_allocator<Pooled>;
+};
+
+UNION(Message
+    , (int, small)
+    , (BOXED(Big), big)
+    , (BOXED(std::string), text)
+    , (BOXED(Pooled), pooled)
+);
+
+UNION(Owner
+    , (BOXED(std::unique_ptr<int>), pointer)
+    , (int, value)
+);
+
+UNION(Key
+    , (BOXED(std::string), name)
+    , (int, id)
+);
+
+// The box keeps the union at the size of a pointer and a tag
+static_assert(sizeof(Message) <= 16);
+static_assert(Message::layout_info().size <= 64);
+static_assert(std::is_same_v<Message::alternative_t<Message::tag_t::big>, Big>);
+static_assert(std::is_same_v<Message::stored_t<Message::tag_t::big>, tu::boxed<Big>>);
+static_assert(std::is_same_v<decltype(std::declval<Message &>().get_big_ref()), Big &>);
+static_assert(!std::is_copy_constructible_v<Owner>);
+static_assert(std::is_nothrow_move_constructible_v<Message>);
+static_assert(!noexcept(Message::create_big()));
+
+static_assert([] {
+    Key key = Key::create_name("ab");
+    Key copy = key;
+    return copy.get_name_ref().size();
+}() == 2);
+
+int main() {
+    // Copies are deep
+    Message big = Message::create_big();
+    big.get_big_ref().id = 7;
+    Message copy = big;
+    CHECK(copy.get_big_ref().id == 7);
+    CHECK(&copy.get_big_ref() != &big.get_big_ref());
+    copy.get_big_ref().id = 8;
+    CHECK(big.get_big_ref().id == 7);
+    big = copy;
+    CHECK(big.get_big_ref().id == 8);
+
+    int id = big.visit_table<int>([](auto, auto const &alternative) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(alternative)>, Big>) {
+            return alternative.id;
+        } else {
+            return 0;
+        }
+    });
+    CHECK(id == 8);
+
+    Message text = Message::create_text("hello");
+    CHECK(text.get_text_ref() == "hello");
+    text.emplace_text("x");
+    CHECK(text.get_text_ref() == "x");
+    text.emplace_small(3);
+    CHECK(text.get_small_ref() == 3);
+    text = Message::create_text("y");
+    std::string moved = std::move(text).get_text_ref();
+    CHECK(moved == "y");
+
+    // Boxes come from tu::box_allocator, also when a copy throws
+    {
+        Message pooled = Message::create_pooled("q");
+        CHECK(live_boxes == 1);
+        Message second = pooled;
+        CHECK(live_boxes == 2);
+        CHECK(second.get_pooled_ref().text == "q");
+        Message failing = Message::create_pooled("f");
+        failing.get_pooled_ref().fail = true;
+        CHECK(live_boxes == 3);
+        CHECK_THROWS(std::runtime_error, Message{failing});
+        CHECK(live_boxes == 3);
+    }
+    CHECK(live_boxes == 0);
+
+    Owner owner = Owner::create_pointer(std::make_unique<int>(4));
+    Owner other = std::move(owner);
+    CHECK(*other.get_pointer_ref() == 4);
+    owner = std::move(other);
+    CHECK(*owner.get_pointer_ref() == 4);
+
+    // Comparison and hashing see the boxed value
+    std::unordered_set<Key> keys{Key::create_name("a"), Key::create_id(1)};
+    CHECK(keys.count(Key::create_name("a")) == 1);
+    CHECK(Key::create_name("a") < Key::create_name("b"));
+    CHECK(Key::create_name("a") == Key::create_name("a"));
+    return 0;
+}
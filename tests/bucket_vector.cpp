@@ -0,0 +1,56 @@
+#include "bucket_vector.hpp"
+
+#include "check.hpp"
+
+#include <string>
+#include <utility>
+
+UNION(Event
+    , (int, index)
+    , (int, value)
+    , (std::string, name)
+    , (struct {}, tick)
+);
+
+int main() {
+    tu::bucket_vector<Event> events;
+    CHECK(events.empty());
+    events.push_back_index(1);
+    events.push_back_value(10);
+    events.push_back_index(2);
+    Event name = Event::create_name("x");
+    events.push_back(name);
+    events.push_back(Event::create_name("y"));
+    events.push_back_tick();
+    events.emplace_back<Event::tag_t::value>(20);
+
+    CHECK(events.size() == 7);
+    CHECK(!events.empty());
+    CHECK(events.count<Event::tag_t::index>() == 2);
+    CHECK(events.count<Event::tag_t::name>() == 2);
+    CHECK(events.bucket<Event::tag_t::name>()[1] == "y");
+    CHECK(name.get_name_ref() == "x");
+
+    // Arms the visitor doesn't accept are skipped
+    int indices = 0, values = 0;
+    events.visit_all(tu::combined_visitor{
+        [&](tu::in_place_tag_t<Event::tag_t::index>, int &i) { indices += i; },
+        [&](tu::in_place_tag_t<Event::tag_t::value>, int &v) {
+            values += v;
+            v = 0;
+        },
+    });
+    CHECK(indices == 3);
+    CHECK(values == 30);
+    CHECK(events.bucket<Event::tag_t::value>()[0] == 0);
+
+    // Buckets are visited in tag order
+    std::string order;
+    std::as_const(events).visit_all([&](auto tag, auto const &) { order += static_cast<char>('0' + static_cast<int>(tag.value)); });
+    CHECK(order == "0011223");
+
+    events.clear();
+    CHECK(events.empty());
+    CHECK(events.size() == 0);
+    return 0;
+}
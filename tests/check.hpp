@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+// Assertions for the tests, active also under NDEBUG
+
+#define CHECK(...)                                                                               \
+    do {                                                                                         \
+        if (!(__VA_ARGS__)) {                                                                    \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #__VA_ARGS__); \
+            std::abort();                                                                        \
+        }                                                                                        \
+    } while (false)
+
+#define CHECK_THROWS(exception, ...)                                                                            \
+    do {                                                                                                        \
+        bool tu_thrown = false;                                                                                 \
+        try {                                                                                                   \
+            __VA_ARGS__;                                                                                        \
+        } catch (exception const &) {                                                                           \
+            tu_thrown = true;                                                                                   \
+        }                                                                                                       \
+        if (!tu_thrown) {                                                                                       \
+            std::fprintf(stderr, "%s:%d: %s did not throw %s\n", __FILE__, __LINE__, #__VA_ARGS__, #exception); \
+            std::abort();                                                                                       \
+        }                                                                                                       \
+    } while (false)
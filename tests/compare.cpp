@@ -0,0 +1,122 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <compare>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+UNION(Key
+    , (int, index)
+    , (int, value)
+    , (std::string, name)
+    , (struct {}, none)
+);
+
+// Only same-sized integral and pointer alternatives: compared and hashed bitwise
+UNION(Word
+    , (int, a)
+    , (unsigned, b)
+    , (int, c)
+);
+
+UNION(Pointer
+    , (int const *, p)
+    , (std::uintptr_t, address)
+);
+
+UNION(Real
+    , (double, d)
+    , (int, i)
+);
+
+struct CaseInsensitive {
+    char c;
+
+    friend bool operator==(CaseInsensitive x, CaseInsensitive y) {
+        return (x.c | 0x20) == (y.c | 0x20);
+    }
+
+    friend std::weak_ordering operator<=>(CaseInsensitive x, CaseInsensitive y) {
+        return (x.c | 0x20) <=> (y.c | 0x20);
+    }
+};
+
+UNION(Letter
+    , (CaseInsensitive, letter)
+    , (int, number)
+);
+
+UNION(Anonymous
+    , (struct { int x; }, point)
+    , (int, i)
+);
+
+template<typename T>
+UNION(Option
+    , (T, some)
+    , (struct {}, none)
+);
+
+int main() {
+    CHECK(Key::create_index(1) == Key::create_index(1));
+    CHECK(Key::create_index(1) != Key::create_index(2));
+    CHECK(Key::create_index(1) != Key::create_value(1));
+    CHECK(Key::create_name("a") < Key::create_name("b"));
+    CHECK(Key::create_none() == Key::create_none());
+    // Tags order first
+    CHECK(Key::create_index(9) < Key::create_value(0));
+    CHECK(Key::create_none() > Key::create_name("z"));
+
+    // The category is the weakest of the alternatives
+    static_assert(std::is_same_v<std::compare_three_way_result_t<Key>, std::strong_ordering>);
+    static_assert(std::is_same_v<std::compare_three_way_result_t<Letter>, std::weak_ordering>);
+    static_assert(std::is_same_v<std::compare_three_way_result_t<Real>, std::partial_ordering>);
+    CHECK(Letter::create_letter(CaseInsensitive{'a'}) == Letter::create_letter(CaseInsensitive{'A'}));
+    CHECK(is_eq(Letter::create_letter(CaseInsensitive{'a'}) <=> Letter::create_letter(CaseInsensitive{'A'})));
+    CHECK(Real::create_d(0.0) == Real::create_d(-0.0));
+    CHECK(is_lt(Real::create_d(1.0) <=> Real::create_i(0)));
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    CHECK((Real::create_d(nan) <=> Real::create_d(nan)) == std::partial_ordering::unordered);
+
+    // Bitwise equality still tells alternatives with equal bits apart
+    CHECK(Word::create_a(5) == Word::create_a(5));
+    CHECK(Word::create_a(5) != Word::create_c(5));
+    CHECK(Word::create_a(-1) != Word::create_b(~0u));
+    CHECK(std::hash<Word>{}(Word::create_b(3u)) == std::hash<Word>{}(Word::create_b(3u)));
+    int x = 0;
+    CHECK(Pointer::create_p(&x) == Pointer::create_p(&x));
+    CHECK(Pointer::create_p(&x) != Pointer::create_address(reinterpret_cast<std::uintptr_t>(&x)));
+
+    // Equal values hash equally
+    CHECK(std::hash<Key>{}(Key::create_name("x")) == std::hash<Key>{}(Key::create_name("x")));
+    CHECK(Key::create_index(4).hash_value() == std::hash<Key>{}(Key::create_index(4)));
+
+    std::unordered_set<Key> keys{Key::create_index(1), Key::create_value(1), Key::create_name("x"), Key::create_none()};
+    CHECK(keys.size() == 4);
+    CHECK(keys.count(Key::create_name("x")) == 1);
+    CHECK(keys.count(Key::create_index(2)) == 0);
+
+    std::unordered_map<Word, int> words;
+    words[Word::create_a(1)] = 1;
+    words[Word::create_c(1)] = 2;
+    words[Word::create_a(1)] += 10;
+    CHECK(words.size() == 2);
+    CHECK(words.at(Word::create_a(1)) == 11);
+
+    // Operations exist only when every alternative supports them
+    static_assert(!std::equality_comparable<Anonymous>);
+    static_assert(!std::three_way_comparable<Anonymous>);
+    static_assert(!std::is_default_constructible_v<std::hash<Anonymous>>);
+    static_assert(!std::is_default_constructible_v<std::hash<Letter>>);
+    static_assert(std::equality_comparable<Option<int>>);
+    CHECK(Option<int>::create_some(1) != Option<int>::create_none());
+    CHECK(Option<int>::create_some(1) < Option<int>::create_none());
+    CHECK(Option<std::unique_ptr<int>>::create_none() == Option<std::unique_ptr<int>>::create_none());
+    std::unordered_set<Option<int>> options{Option<int>::create_none(), Option<int>::create_some(0)};
+    CHECK(options.size() == 2);
+    return 0;
+}
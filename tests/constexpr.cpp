@@ -0,0 +1,98 @@
+#include "tagged_union.hpp"
+
+#include <array>
+#include <string>
+
+UNION(Instruction
+    , (int, push)
+    , (struct {}, add)
+    , (struct {}, mul)
+    , (int, jump)
+);
+
+// A table built at compile time
+constexpr std::array<Instruction, 5> program = {
+    Instruction::create_push(2), Instruction::create_push(3), Instruction::create_add(), Instruction::create_push(4), Instruction::create_mul(),
+};
+
+static_assert(program[1].get_push_ref() == 3);
+static_assert(program[2].holds_add());
+static_assert(program[0].get_jump_ptr() == nullptr);
+static_assert(program[4].get_tag() == Instruction::tag_t::mul);
+
+constexpr int evaluate() {
+    int stack[8]{};
+    int top = 0;
+    for (auto const &instruction : program) {
+        MATCH(void, instruction
+            , CASE(push, value, { stack[top++] = value; })
+            , CASE(add, operation, {
+                (void)operation;
+                --top;
+                stack[top - 1] += stack[top];
+            })
+            , CASE(mul, operation, {
+                (void)operation;
+                --top;
+                stack[top - 1] *= stack[top];
+            })
+            , CASE(jump, target, { (void)target; }));
+    }
+    return stack[0];
+}
+
+static_assert(evaluate() == 20);
+
+constexpr int visit_each() {
+    int sum = 0;
+    for (auto const &instruction : program) {
+        sum += instruction.visit<int>(tu::combined_visitor{
+            [](tu::in_place_tag_t<Instruction::tag_t::push>, int value) { return value; },
+            [](auto, auto const &) { return 100; },
+        });
+        sum += instruction.visit_table<int>([](auto tag, auto const &) { return static_cast<int>(tag.value); });
+    }
+    return sum;
+}
+
+static_assert(visit_each() == 2 + 3 + 4 + 200 + (0 + 0 + 1 + 0 + 2));
+
+// Non-trivial special members, emplace and comparison with an allocating alternative
+UNION(Text
+    , (std::string, text)
+    , (int, number)
+);
+
+constexpr bool special_members() {
+    Text a = Text::create_text("long enough to be allocated on the heap, not in place");
+    a.emplace_number(3);
+    Text b = a;
+    b.emplace_text("x");
+    a = b;
+    Text c = std::move(b);
+    c = Text::create_number(7);
+    return a.get_text_ref() == "x" && c.get_number_ref() == 7 && a != c && (c <=> a) > 0
+        && a.visit_expect<Text::tag_t::text, std::size_t>([](auto, auto const &value) {
+               if constexpr (requires { value.size(); }) {
+                   return value.size();
+               } else {
+                   return std::size_t(0);
+               }
+           }) == 1;
+}
+
+static_assert(special_members());
+
+UNION_WITH_LAYOUT(Last, tu::layout::tag_last
+    , (int, a)
+    , (int, b)
+);
+
+static_assert(Last::create_b(1).holds_b());
+static_assert(Last::create_a(1) == Last::create_a(1));
+static_assert(Last::create_a(1) != Last::create_b(1));
+static_assert(tu::visit<int>([](auto, auto, int x, int y) { return x + y; }, Last::create_a(1), Last::create_b(2)) == 3);
+
+int main() {
+    return evaluate() == 20 ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+#include "coro.hpp"
+
+#include "check.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+UNION(Job
+    , (int, add)
+    , (std::string, text)
+    , (double, slow)
+    , (long, fail)
+);
+
+using task = tu::async_task<int, Job>;
+
+// Eagerly started coroutine that drives the awaits of a test
+struct driver {
+    struct promise_type {
+        driver get_return_object() noexcept {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept {
+            std::abort();
+        }
+    };
+};
+
+// Awaitable that suspends until the test resumes it
+std::vector<std::coroutine_handle<>> parked;
+
+struct park {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        parked.push_back(handle);
+    }
+
+    int await_resume() const noexcept {
+        return 5;
+    }
+};
+
+void resume_parked() {
+    CHECK(parked.size() == 1);
+    std::coroutine_handle<> handle = parked.back();
+    parked.clear();
+    handle.resume();
+}
+
+task slow_handler(double value) {
+    int resumed = co_await park{};
+    co_return resumed + static_cast<int>(value);
+}
+
+int total = 0;
+
+driver run(Job &job) {
+    try {
+        total += co_await tu::co_visit<int>(job, tu::combined_visitor{
+            [](tu::in_place_tag_t<Job::tag_t::add>, int value) { return value; },
+            [](tu::in_place_tag_t<Job::tag_t::text>, std::string &text) -> task { co_return static_cast<int>(text.size()); },
+            [](tu::in_place_tag_t<Job::tag_t::slow>, double value) { return slow_handler(value); },
+            [](tu::in_place_tag_t<Job::tag_t::fail>, long) -> task {
+                throw std::runtime_error("failed");
+                co_return 0;
+            },
+        });
+    } catch (std::runtime_error const &) {
+        total += 1000;
+    }
+}
+
+struct Matcher {
+    int case_add(int value) const {
+        return value * 2;
+    }
+
+    park case_slow(double) const {
+        return {};
+    }
+
+    task otherwise(Job const &) const {
+        co_return -1;
+    }
+};
+
+driver run_match(Job const &job) {
+    total += co_await tu::async_match<int>(job, Matcher{});
+}
+
+int voids = 0;
+
+driver run_void(Job &job) {
+    co_await tu::co_visit<void>(job, tu::combined_visitor{
+        [](tu::in_place_tag_t<Job::tag_t::add>, int value) { voids += value; },
+        [](auto, auto &) -> tu::async_task<void, Job> {
+            voids += 100;
+            co_return;
+        },
+    });
+}
+
+int main() {
+    using pool = tu::frame_pool<Job>;
+    Job add = Job::create_add(3);
+    Job text = Job::create_text("hello");
+    Job slow = Job::create_slow(2.0);
+    Job fail = Job::create_fail(1L);
+
+    // A synchronous arm is ready without a frame
+    run(add);
+    CHECK(total == 3);
+    CHECK(pool::block_size() == 0 && pool::cached() == 0);
+
+    // A coroutine arm takes a frame from the pool and returns it when the task is destroyed
+    run(text);
+    CHECK(total == 8);
+    std::size_t block = pool::block_size();
+    CHECK(block > 0 && pool::cached() == 1);
+    for (int i = 0; i < 100; ++i) {
+        run(text);
+    }
+    CHECK(total == 508);
+    CHECK(pool::block_size() == block && pool::cached() == 1);
+
+    // While a task is suspended its frame is out of the pool
+    run(slow);
+    CHECK(total == 508);
+    resume_parked();
+    CHECK(total == 515);
+    CHECK(pool::cached() >= 1);
+
+    // An exception thrown by the arm is rethrown by the co_await, and the frame is still returned
+    std::size_t cached = pool::cached();
+    run(fail);
+    CHECK(total == 1515);
+    CHECK(pool::cached() == cached);
+
+    // Matchers may return values, tasks and other awaitables
+    run_match(add);
+    CHECK(total == 1521);
+    run_match(slow);
+    resume_parked();
+    CHECK(total == 1526);
+    run_match(text);
+    CHECK(total == 1525);
+
+    run_void(add);
+    run_void(text);
+    CHECK(voids == 103);
+
+    // A frame freed on another thread goes to that thread's list, which has no blocks of its size, so it is deleted
+    run(slow);
+    std::thread([] {
+        resume_parked();
+        CHECK(pool::cached() == 0);
+    }).join();
+    CHECK(total == 1532);
+
+    pool::release();
+    CHECK(pool::cached() == 0);
+}
@@ -0,0 +1,91 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <string>
+
+UNION(Token
+    , (int, number)
+    , (std::string, word)
+    , (char, symbol)
+);
+
+// Handles number and word but not symbol, also when nothing is returned
+struct Partial {
+    void case_number(int) const {}
+    void case_word(std::string const &) const {}
+};
+
+struct Ignore {
+    int &m_count;
+
+    void case_number(int) const {}
+    void otherwise(Token const &) const {
+        ++m_count;
+    }
+};
+
+int main() {
+    Token token = Token::create_symbol('+');
+    int count = 0;
+
+    // A catch-all arm for the union opts out of the check, also for void
+    token.visit<void>(tu::combined_visitor{
+        [&](tu::in_place_tag_t<Token::tag_t::number>, int) {},
+        [&](Token const &) { ++count; },
+    });
+    token.match<void>(Ignore{count});
+    MATCH(void, token
+        , CASE(number, number, { (void)number; })
+        , OTHERWISE(other, {
+            (void)other;
+            ++count;
+        }));
+    MATCH_SWITCH(void, token
+        , CASE(word, word, { (void)word; })
+        , OTHERWISE(other, {
+            (void)other;
+            ++count;
+        }));
+    tu::visit<void>(tu::combined_visitor{
+        [&](tu::in_place_tag_t<Token::tag_t::number>, tu::in_place_tag_t<Token::tag_t::number>, int, int) {},
+        [&](Token const &, Token const &) { ++count; },
+    }, token, token);
+    CHECK(count == 5);
+
+    // Covering every alternative needs no catch-all
+    MATCH_SWITCH(void, token
+        , CASE(number, number, { (void)number; })
+        , CASE(word, word, { (void)word; })
+        , CASE(symbol, symbol, { count += symbol == '+'; }));
+    CHECK(count == 6);
+
+#if defined(TU_FAIL_VISIT_VOID)
+    token.visit<void>([](tu::in_place_tag_t<Token::tag_t::number>, int) {});
+#elif defined(TU_FAIL_VISIT_VALUE)
+    (void)token.visit<int>([](tu::in_place_tag_t<Token::tag_t::number>, int number) { return number; });
+#elif defined(TU_FAIL_VISIT_TABLE_VOID)
+    token.visit_table<void>([](tu::in_place_tag_t<Token::tag_t::number>, int) {});
+#elif defined(TU_FAIL_MATCH_VOID)
+    token.match<void>(Partial{});
+#elif defined(TU_FAIL_MATCH_MACRO_VOID)
+    MATCH(void, token
+        , CASE(number, number, { (void)number; })
+        , CASE(word, word, { (void)word; }));
+#elif defined(TU_FAIL_MATCH_SWITCH_VOID)
+    MATCH_SWITCH(void, token
+        , CASE(number, number, { (void)number; })
+        , CASE(word, word, { (void)word; }));
+#elif defined(TU_FAIL_MATCH_SWITCH_VALUE)
+    (void)MATCH_SWITCH(int, token, CASE(number, number, { return number; }));
+#elif defined(TU_FAIL_MATCH_SWITCH_NO_RETURN)
+    (void)MATCH_SWITCH(int, token
+        , CASE(number, number, { (void)number; })
+        , OTHERWISE(other, {
+            (void)other;
+            return 0;
+        }));
+#elif defined(TU_FAIL_MULTI_VISIT_VOID)
+    tu::visit<void>([](tu::in_place_tag_t<Token::tag_t::number>, tu::in_place_tag_t<Token::tag_t::number>, int, int) {}, token, token);
+#endif
+}
@@ -0,0 +1,92 @@
+#define TU_INSTRUMENT
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <string>
+#include <thread>
+
+UNION(Value
+    , (int, number)
+    , (std::string, text)
+    , (double, real)
+);
+
+// Instrumentation doesn't change the special members
+UNION(Plain
+    , (int, a)
+    , (float, b)
+);
+
+static_assert(std::is_trivially_copyable_v<Plain>);
+static_assert(std::is_trivially_copy_assignable_v<Plain>);
+static_assert(std::is_trivially_move_assignable_v<Plain>);
+
+// Constant evaluation isn't counted
+constexpr int evaluated() {
+    Plain plain = Plain::create_a(1);
+    plain.emplace_b(2.0f);
+    plain = Plain::create_a(3);
+    return plain.visit<int>([](auto, auto value) { return static_cast<int>(value); });
+}
+
+static_assert(evaluated() == 3);
+
+struct Ignore {
+    void otherwise(Value &) const {}
+};
+
+std::size_t index(Value::tag_t tag) {
+    return static_cast<std::size_t>(tag);
+}
+
+int main() {
+    using tag = Value::tag_t;
+    Value value = Value::create_number(1);
+    value.visit<void>([](auto, auto &) {});
+    value.match<void>(Ignore{});
+    value.visit_table<void>([](auto, auto &) {});
+    value.visit_expect<tag::number, void>([](auto, auto &) {});
+    value.emplace_text("x");
+    value.emplace_real(2);
+    value.emplace_real(3);
+
+    // Assignment is not counted
+    Value number = Value::create_number(4);
+    value = number;
+    value = Value::create_text("y");
+
+    // Counts of all threads are summed, including those that finished
+    std::thread thread([] {
+        Value text = Value::create_text("a");
+        for (int i = 0; i < 1000; ++i) {
+            text.visit<void>([](auto, auto &) {});
+        }
+        text.emplace_number(1);
+    });
+    thread.join();
+
+    auto stats = Value::stats();
+    CHECK(stats.visits[index(tag::number)] == 4);
+    CHECK(stats.visits[index(tag::text)] == 1000);
+    CHECK(stats.visits[index(tag::real)] == 0);
+    CHECK(stats.transitions[index(tag::number)][index(tag::text)] == 1);
+    CHECK(stats.transitions[index(tag::text)][index(tag::real)] == 1);
+    CHECK(stats.transitions[index(tag::real)][index(tag::real)] == 1);
+    CHECK(stats.transitions[index(tag::text)][index(tag::number)] == 1);
+    CHECK(stats.transitions[index(tag::real)][index(tag::number)] == 0);
+    CHECK(stats.transitions[index(tag::number)][index(tag::text)] == 1);
+
+    // Trivial unions count visits and emplace, but not their trivial assignment
+    Plain plain = Plain::create_a(1);
+    plain.emplace_b(2.0f);
+    plain = Plain::create_a(3);
+    plain.visit<void>([](auto, auto) {});
+    MATCH_SWITCH(void, plain, CASE(a, a, { (void)a; }), CASE(b, b, { (void)b; }));
+    CHECK(plain.get_a_ref() == 3);
+    auto plain_stats = Plain::stats();
+    CHECK(plain_stats.visits[0] == 2);
+    CHECK(plain_stats.transitions[0][1] == 1);
+    CHECK(plain_stats.transitions[1][0] == 0);
+    return 0;
+}
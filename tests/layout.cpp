@@ -0,0 +1,78 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <cstring>
+#include <string>
+
+UNION(Small
+    , (char, c)
+    , (short, s)
+);
+
+UNION_WITH_LAYOUT(SmallLast, tu::layout::tag_last
+    , (char, c)
+    , (short, s)
+);
+
+UNION_WITH_LAYOUT(NamedLast, tu::layout::tag_last
+    , (int, index)
+    , (std::string, name)
+);
+
+UNION(Wide
+    , (double, d)
+    , (char, c)
+);
+
+static_assert(std::is_same_v<std::underlying_type_t<Small::tag_t>, std::uint8_t>);
+static_assert(sizeof(Small) == 4);
+
+static_assert(Small::layout_info().size == sizeof(Small));
+static_assert(Small::layout_info().align == alignof(Small));
+static_assert(Small::layout_info().tag_size == 1);
+static_assert(Small::layout_info().tag_offset == 0);
+static_assert(Small::layout_info().storage_offset == 2);
+static_assert(Small::layout_info().storage_size == 2);
+static_assert(Small::layout_info().wasted == 1);
+
+static_assert(SmallLast::layout_info().size == 4);
+static_assert(SmallLast::layout_info().tag_offset == 2);
+static_assert(SmallLast::layout_info().storage_offset == 0);
+static_assert(std::is_trivially_copyable_v<SmallLast>);
+
+static_assert(Wide::layout_info().size == 2 * sizeof(double));
+static_assert(Wide::layout_info().wasted == sizeof(double) - 1);
+
+static_assert(NamedLast::layout_info().storage_offset == 0);
+static_assert(NamedLast::layout_info().tag_offset == sizeof(std::string));
+
+int main() {
+    {
+        SmallLast u = SmallLast::create_s(7);
+        CHECK(u.holds_s() && u.get_s_ref() == 7);
+        CHECK(static_cast<void const *>(&u.get_s_ref()) == static_cast<void const *>(&u));
+        unsigned char tag;
+        std::memcpy(&tag, reinterpret_cast<unsigned char const *>(&u) + SmallLast::layout_info().tag_offset, 1);
+        CHECK(tag == static_cast<unsigned char>(SmallLast::tag_t::s));
+        u.emplace_c('x');
+        CHECK(u.holds_c() && u.get_c_ref() == 'x');
+    }
+    {
+        Small u = Small::create_c('y');
+        unsigned char tag;
+        std::memcpy(&tag, &u, 1);
+        CHECK(tag == static_cast<unsigned char>(Small::tag_t::c));
+        CHECK(reinterpret_cast<char const *>(&u.get_c_ref()) == reinterpret_cast<char const *>(&u) + 2);
+    }
+    {
+        NamedLast a = NamedLast::create_name("hello");
+        NamedLast b = a;
+        b = NamedLast::create_index(3);
+        CHECK(a.get_name_ref() == "hello");
+        CHECK(b.holds_index() && b.get_index_ref() == 3);
+        b = std::move(a);
+        CHECK(b.holds_name() && b.get_name_ref() == "hello");
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <string>
+
+UNION(One
+    , (int, only)
+);
+
+UNION(Ten
+    , (int, f0), (int, f1), (int, f2), (int, f3), (int, f4), (int, f5), (int, f6), (int, f7), (int, f8), (std::string, f9)
+);
+
+UNION(Max
+    , (std::string, f0), (int, f1), (int, f2), (int, f3), (int, f4), (int, f5), (int, f6), (int, f7), (int, f8), (int, f9), (int, f10), (int, f11), (int, f12), (int, f13), (int, f14), (int, f15)
+    , (int, f16), (int, f17), (int, f18), (int, f19), (int, f20), (int, f21), (int, f22), (int, f23), (int, f24), (int, f25), (int, f26), (int, f27), (int, f28), (int, f29), (int, f30), (int, f31)
+    , (int, f32), (int, f33), (int, f34), (int, f35), (int, f36), (int, f37), (int, f38), (int, f39), (int, f40), (int, f41), (int, f42), (int, f43), (int, f44), (int, f45), (int, f46), (int, f47)
+    , (int, f48), (int, f49), (int, f50), (int, f51), (int, f52), (int, f53), (int, f54), (int, f55), (int, f56), (int, f57), (int, f58), (int, f59), (int, f60), (int, f61), (int, f62), (int, f63)
+    , (std::string, f64), (int, f65), (int, f66), (int, f67), (int, f68), (int, f69), (int, f70), (int, f71), (int, f72), (int, f73), (int, f74), (int, f75), (int, f76), (int, f77), (int, f78), (int, f79)
+    , (int, f80), (int, f81), (int, f82), (int, f83), (int, f84), (int, f85), (int, f86), (int, f87), (int, f88), (int, f89), (int, f90), (int, f91), (int, f92), (int, f93), (int, f94), (int, f95)
+    , (int, f96), (int, f97), (int, f98), (int, f99), (int, f100), (int, f101), (int, f102), (int, f103), (int, f104), (int, f105), (int, f106), (int, f107), (int, f108), (int, f109), (int, f110), (int, f111)
+    , (int, f112), (int, f113), (int, f114), (int, f115), (int, f116), (int, f117), (int, f118), (int, f119), (int, f120), (int, f121), (int, f122), (int, f123), (int, f124), (int, f125), (int, f126), (int, f127)
+    , (std::string, f128), (int, f129), (int, f130), (int, f131), (int, f132), (int, f133), (int, f134), (int, f135), (int, f136), (int, f137), (int, f138), (int, f139), (int, f140), (int, f141), (int, f142), (int, f143)
+    , (int, f144), (int, f145), (int, f146), (int, f147), (int, f148), (int, f149), (int, f150), (int, f151), (int, f152), (int, f153), (int, f154), (int, f155), (int, f156), (int, f157), (int, f158), (int, f159)
+    , (int, f160), (int, f161), (int, f162), (int, f163), (int, f164), (int, f165), (int, f166), (int, f167), (int, f168), (int, f169), (int, f170), (int, f171), (int, f172), (int, f173), (int, f174), (int, f175)
+    , (int, f176), (int, f177), (int, f178), (int, f179), (int, f180), (int, f181), (int, f182), (int, f183), (int, f184), (int, f185), (int, f186), (int, f187), (int, f188), (int, f189), (int, f190), (int, f191)
+    , (std::string, f192), (int, f193), (int, f194), (int, f195), (int, f196), (int, f197), (int, f198), (int, f199), (int, f200), (int, f201), (int, f202), (int, f203), (int, f204), (int, f205), (int, f206), (int, f207)
+    , (int, f208), (int, f209), (int, f210), (int, f211), (int, f212), (int, f213), (int, f214), (int, f215), (int, f216), (int, f217), (int, f218), (int, f219), (int, f220), (int, f221), (int, f222), (int, f223)
+    , (int, f224), (int, f225), (int, f226), (int, f227), (int, f228), (int, f229), (int, f230), (int, f231), (int, f232), (int, f233), (int, f234), (int, f235), (int, f236), (int, f237), (int, f238), (int, f239)
+    , (int, f240), (int, f241), (int, f242), (int, f243), (int, f244), (int, f245), (int, f246), (int, f247), (int, f248), (int, f249), (int, f250), (int, f251), (int, f252), (int, f253), (int, f254), (int, f255)
+);
+
+static_assert(One::alternative_count == 1);
+static_assert(Ten::alternative_count == 10);
+static_assert(Max::alternative_count == 256);
+static_assert(std::is_same_v<std::underlying_type_t<Max::tag_t>, std::uint8_t>);
+static_assert(static_cast<std::size_t>(Max::tag_t::f255) == 255);
+
+struct LastMatcher {
+    int case_f255(int value) { return value; }
+    int otherwise(Max const &) { return -1; }
+};
+
+int main() {
+    {
+        One u = One::create_only(1);
+        CHECK(u.holds_only() && u.get_only_ref() == 1);
+    }
+    {
+        Ten u = Ten::create_f9("nine");
+        CHECK(u.holds_f9() && u.get_f9_ref() == "nine");
+        CHECK(u.visit<std::size_t>([](auto tag, auto const &) { return static_cast<std::size_t>(decltype(tag)::value); }) == 9);
+    }
+    {
+        Max u = Max::create_f255(255);
+        CHECK(u.holds_f255() && u.get_f255_ref() == 255);
+        CHECK(u.visit<std::size_t>([](auto tag, auto const &) { return static_cast<std::size_t>(decltype(tag)::value); }) == 255);
+        CHECK(u.visit_table<std::size_t>([](auto tag, auto const &) { return static_cast<std::size_t>(decltype(tag)::value); }) == 255);
+        CHECK(u.match<int>(LastMatcher{}) == 255);
+        Max copy = u;
+        CHECK(copy.get_f255_ref() == 255);
+        u.emplace_f192("one hundred ninety-two");
+        CHECK(u.holds_f192() && u.get_f192_ref() == "one hundred ninety-two");
+        CHECK(u.match<int>(LastMatcher{}) == -1);
+        copy = u;
+        CHECK(copy.get_f192_ref() == u.get_f192_ref());
+    }
+    return 0;
+}
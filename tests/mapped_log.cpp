@@ -0,0 +1,145 @@
+#include "mapped_log.hpp"
+
+#include "check.hpp"
+
+#include <fstream>
+#include <string>
+
+UNION(Record
+    , (std::int64_t, ok)
+    , (std::string, error)
+    , (struct { double a; double b; }, pair)
+    , (struct {}, mark)
+    , (bool, flag)
+);
+
+struct temp_log {
+    explicit temp_log(char const *name) : path(std::filesystem::temp_directory_path() / name) {
+        remove();
+    }
+
+    ~temp_log() {
+        remove();
+    }
+
+    void remove() {
+        std::filesystem::remove(path);
+        std::filesystem::remove(std::filesystem::path(path) += ".index");
+    }
+
+    std::filesystem::path path;
+};
+
+int main() {
+    temp_log file("tu_mapped_log_test");
+    constexpr int count = 20000;
+    {
+        tu::mapped_log<Record> log(file.path);
+        CHECK(log.empty());
+        for (int i = 0; i < count; ++i) {
+            if (i % 100 == 0) {
+                log.append(Record::create_error("e" + std::to_string(i)));
+            } else if (i % 3 == 0) {
+                log.append(Record::create_pair(i, i * 2.0));
+            } else if (i % 7 == 0) {
+                log.append(Record::create_mark());
+            } else {
+                log.append(Record::create_ok(i));
+            }
+        }
+        CHECK(log.size() == count);
+        log.sync();
+    }
+
+    {
+        tu::mapped_log<Record> const log(file.path, false);
+        CHECK(log.size() == count);
+        CHECK(log.offsets<Record::tag_t::error>().size() == count / 100);
+        CHECK(log[1].holds_ok());
+        CHECK(log[1].get_ok_ref() == 1);
+        CHECK(log[3].get_pair_ref().b == 6.0);
+        CHECK(log.at(log.offsets<Record::tag_t::error>()[1]).load().get_error_ref() == "e100");
+
+        std::size_t errors = 0;
+        log.for_each<Record::tag_t::error>([&](std::string const &error) {
+            CHECK(error == "e" + std::to_string(errors * 100));
+            ++errors;
+        });
+        CHECK(errors == count / 100);
+
+        double drift = 0;
+        std::size_t pairs = 0;
+        log.for_each<Record::tag_t::pair>([&](auto const &pair) {
+            drift += pair.b - 2 * pair.a;
+            ++pairs;
+        });
+        CHECK(drift == 0);
+        CHECK(pairs == log.offsets<Record::tag_t::pair>().size());
+
+        std::size_t all = 0;
+        log.for_each([&](tu::view<Record> record) {
+            CHECK(record.valid());
+            ++all;
+        });
+        CHECK(all == count);
+    }
+
+    // Reopening for writing appends after the existing records
+    {
+        tu::mapped_log<Record> log(file.path);
+        log.append(Record::create_error("tail"));
+        CHECK(log.size() == count + 1);
+        CHECK(log[count].load().get_error_ref() == "tail");
+        CHECK(log.offsets<Record::tag_t::error>().size() == count / 100 + 1);
+    }
+
+    CHECK_THROWS(std::system_error, tu::mapped_log<Record>("/nonexistent/directory/log", false));
+    CHECK_THROWS(std::system_error, tu::mapped_log<Record>("/nonexistent/directory/log"));
+
+    // Files that are not logs are rejected
+    temp_log other("tu_mapped_log_other");
+    std::ofstream(other.path) << "not a log, but long enough to hold a header";
+    std::ofstream(std::filesystem::path(other.path) += ".index") << "not an index, but long enough to hold a header";
+    CHECK_THROWS(std::system_error, tu::mapped_log<Record>(other.path, false));
+
+    // Logs whose header or index point outside the files are rejected: word is written at offset at of the copied
+    // data file, or of its index if in_index is set
+    auto corrupted = [&](bool in_index, std::streamoff at, std::uint64_t word) {
+        temp_log copy("tu_mapped_log_corrupted");
+        std::filesystem::copy_file(file.path, copy.path);
+        std::filesystem::copy_file(std::filesystem::path(file.path) += ".index", std::filesystem::path(copy.path) += ".index");
+        {
+            std::fstream stream(in_index ? std::filesystem::path(copy.path) += ".index" : copy.path, std::ios::in | std::ios::out | std::ios::binary);
+            stream.seekp(at);
+            stream.write(reinterpret_cast<char const *>(&word), sizeof(word));
+        }
+        CHECK_THROWS(std::system_error, tu::mapped_log<Record>(copy.path, false));
+    };
+    // The header is 64 bytes, with the end of the data or the number of index entries at offset 8, and the first
+    // record and the first index entry follow it. An entry holds the tag in its top byte.
+    corrupted(false, 8, ~std::uint64_t(0));
+    corrupted(false, 8, 0);
+    corrupted(true, 8, std::uint64_t(1) << 40);
+    corrupted(true, 64, 64 | std::uint64_t(0x7f) << 56);
+    corrupted(true, 64, 8);
+    corrupted(false, 64, std::uint64_t(1) << 40);
+
+    // A record that is not a valid object representation is not read in place
+    temp_log flags("tu_mapped_log_flags");
+    std::uint64_t offset = 0;
+    {
+        tu::mapped_log<Record> log(flags.path);
+        log.append(Record::create_flag(true));
+        offset = log.offsets<Record::tag_t::flag>()[0];
+        log.sync();
+    }
+    {
+        std::fstream data(flags.path, std::ios::in | std::ios::out | std::ios::binary);
+        data.seekp(static_cast<std::streamoff>(offset + sizeof(std::uint64_t) + 1));
+        data.put(0x42);
+    }
+    tu::mapped_log<Record> const log(flags.path, false);
+    CHECK(!log[0].valid());
+    CHECK_THROWS(std::system_error, log.for_each<Record::tag_t::flag>([](bool) {}));
+    return 0;
+}
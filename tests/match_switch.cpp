@@ -0,0 +1,103 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <memory>
+#include <string>
+
+UNION(Shape
+    , (int, circle)
+    , (double, square)
+    , (std::string, label)
+    , (std::unique_ptr<int>, owned)
+);
+
+int partial(Shape const &shape) {
+    return MATCH_SWITCH(int, shape
+        , CASE(circle, radius, { return radius * 3; })
+        , CASE(square, side, { return static_cast<int>(side * side); })
+        , OTHERWISE(other, { return static_cast<int>(other.get_tag()) * 100; }));
+}
+
+int exhaustive(Shape &shape) {
+    return MATCH_SWITCH(int, shape
+        , CASE(circle, radius, {
+            radius += 1;
+            return radius;
+        })
+        , CASE(square, side, { return static_cast<int>(side); })
+        , CASE(label, text, { return static_cast<int>(text.size()); })
+        , CASE(owned, pointer, { return *pointer; }));
+}
+
+// Arms bind with the value category of the matched expression
+template<typename U>
+int take_owned(U &&shape) {
+    return MATCH_SWITCH(int, std::forward<U>(shape)
+        , CASE(owned, pointer, {
+            auto taken = std::move(pointer);
+            return *taken;
+        })
+        , OTHERWISE(other, {
+            (void)other;
+            return -1;
+        }));
+}
+
+UNION(Number
+    , (int, small)
+    , (long, large)
+);
+
+constexpr int evaluated() {
+    Number number = Number::create_large(7L);
+    return MATCH_SWITCH(int, number
+        , CASE(small, value, { return value; })
+        , CASE(large, value, { return static_cast<int>(value) * 2; }));
+}
+
+static_assert(evaluated() == 14);
+
+int main() {
+    Shape shape = Shape::create_circle(2);
+    CHECK(partial(shape) == 6);
+    CHECK(exhaustive(shape) == 3);
+    CHECK(shape.get_circle_ref() == 3);
+    shape.emplace_label("hello");
+    CHECK(partial(shape) == 200);
+    CHECK(exhaustive(shape) == 5);
+
+    int hits = 0;
+    MATCH_SWITCH(void, shape
+        , CASE(label, text, { hits += static_cast<int>(text.size()); })
+        , OTHERWISE(other, {
+            (void)other;
+            hits += 1000;
+        }));
+    CHECK(hits == 5);
+    MATCH_SWITCH(void, Shape::create_circle(1), OTHERWISE(other, { hits += other.get_circle_ref(); }));
+    CHECK(hits == 6);
+
+    shape.emplace_owned(std::make_unique<int>(42));
+    CHECK(take_owned(shape) == 42);
+    CHECK(!shape.get_owned_ref());
+    shape.emplace_owned(std::make_unique<int>(9));
+    CHECK(take_owned(std::move(shape)) == 9);
+    CHECK(take_owned(Shape::create_circle(1)) == -1);
+
+    // The union is evaluated once
+    int evaluations = 0;
+    auto next = [&] {
+        ++evaluations;
+        return Shape::create_square(2.0);
+    };
+    int side = MATCH_SWITCH(int, next()
+        , CASE(square, side, { return static_cast<int>(side); })
+        , OTHERWISE(other, {
+            (void)other;
+            return 0;
+        }));
+    CHECK(side == 2);
+    CHECK(evaluations == 1);
+    return 0;
+}
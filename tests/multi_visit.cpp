@@ -0,0 +1,66 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <string>
+
+UNION(Value
+    , (long, integer)
+    , (double, real)
+    , (std::string, text)
+);
+
+UNION(Op
+    , (struct {}, add)
+    , (struct {}, mul)
+);
+
+Value add(Value const &a, Value const &b) {
+    return MATCH2(Value, a, b
+        , CASE2(integer, integer, x, y, { return Value::create_integer(x + y); })
+        , CASE2(real, real, x, y, { return Value::create_real(x + y); })
+        , CASE2(integer, real, x, y, { return Value::create_real(static_cast<double>(x) + y); })
+        , CASE2(text, text, x, y, { return Value::create_text(x + y); })
+        , OTHERWISE2(x, y, {
+            (void)x;
+            (void)y;
+            return Value::create_text("type mismatch");
+        })
+    );
+}
+
+int main() {
+    CHECK(add(Value::create_integer(1), Value::create_integer(2)).get_integer_ref() == 3);
+    CHECK(add(Value::create_integer(1), Value::create_real(0.5)).get_real_ref() == 1.5);
+    CHECK(add(Value::create_text("a"), Value::create_text("b")).get_text_ref() == "ab");
+    CHECK(add(Value::create_real(1), Value::create_text("b")).get_text_ref() == "type mismatch");
+    CHECK(add(Value::create_real(0.5), Value::create_integer(1)).get_text_ref() == "type mismatch");
+
+    // Alternatives are forwarded with the value category of their union
+    Value text = Value::create_text("moved");
+    std::string out;
+    tu::visit<void>([&](auto, auto, auto &&lhs, auto &&) {
+        if constexpr (std::is_same_v<decltype(lhs), std::string &&>) {
+            out = std::move(lhs);
+        }
+    }, std::move(text), Value::create_integer(0));
+    CHECK(out == "moved");
+
+    // Three unions: every combination of tags has its own table entry
+    for (int a = 0; a < 2; ++a) {
+        for (int c = 0; c < 2; ++c) {
+            Op lhs = a ? Op::create_mul() : Op::create_add();
+            Op rhs = c ? Op::create_mul() : Op::create_add();
+            int n = tu::visit<int>([](auto x, auto y, auto z, auto &&, auto &&, auto &&) {
+                return static_cast<int>(x.value) * 100 + static_cast<int>(y.value) * 10 + static_cast<int>(z.value);
+            }, lhs, Value::create_text("x"), rhs);
+            CHECK(n == a * 100 + 20 + c);
+        }
+    }
+
+    // A visitor that takes the unions themselves
+    auto tags = tu::visit<int>([](Value const &x, Op const &y) { return static_cast<int>(x.get_tag()) * 10 + static_cast<int>(y.get_tag()); },
+        Value::create_real(1), Op::create_mul());
+    CHECK(tags == 11);
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+template<typename T>
+UNION(Option
+    , (T, some)
+    , (struct {}, none)
+);
+
+UNION(Pointers
+    , (struct {}, a)
+    , (int *, p)
+    , (struct {}, b)
+    , (struct {}, c)
+);
+
+// short * has alignof(short) - 1 niches, too few for three empty alternatives
+UNION(TooMany
+    , (struct {}, a)
+    , (short *, p)
+    , (struct {}, b)
+    , (struct {}, c)
+);
+
+UNION(Flag
+    , (bool, on)
+    , (struct {}, unknown)
+);
+
+UNION(Text
+    , (std::string, text)
+    , (struct {}, none)
+);
+
+// Pointer wrapper that is never null, so the null representation encodes the empty alternative
+struct NonNull {
+    int *ptr;
+};
+
+template<>
+struct tu::niche<NonNull> {
+    static constexpr std::size_t count = 1;
+
+    static void store(void *p, std::size_t) noexcept {
+        std::memset(p, 0, sizeof(NonNull));
+    }
+
+    static std::size_t load(void const *p) noexcept {
+        std::uintptr_t bits;
+        std::memcpy(&bits, p, sizeof(bits));
+        return bits == 0 ? 0 : count;
+    }
+};
+
+UNION(Handle
+    , (NonNull, valid)
+    , (struct {}, closed)
+);
+
+static_assert(sizeof(Option<int *>) == sizeof(int *));
+static_assert(sizeof(Option<char *>) == 2 * sizeof(char *));
+static_assert(sizeof(Option<bool>) == 1);
+static_assert(sizeof(Pointers) == sizeof(int *));
+static_assert(sizeof(TooMany) > sizeof(short *));
+static_assert(sizeof(Flag) == 1);
+static_assert(sizeof(Text) > sizeof(std::string));
+static_assert(sizeof(Handle) == sizeof(NonNull));
+static_assert(Option<int *>::layout_info().tag_size == 0);
+static_assert(Option<int *>::layout_info().wasted == 0);
+static_assert(std::is_trivially_copyable_v<Option<int *>>);
+
+int main() {
+    {
+        int x = 5;
+        auto o = Option<int *>::create_some(&x);
+        CHECK(o.holds_some() && *o.get_some_ref() == 5);
+        o.emplace_none();
+        CHECK(o.holds_none() && o.get_tag() == Option<int *>::tag_t::none);
+        CHECK(o.get_some_ptr() == nullptr);
+        // A null pointer is a valid value, not a niche
+        o = Option<int *>::create_some(nullptr);
+        CHECK(o.holds_some() && o.get_some_ref() == nullptr);
+    }
+    {
+        int x = 0;
+        std::vector<Pointers> v{Pointers::create_a(), Pointers::create_p(&x), Pointers::create_b(), Pointers::create_c()};
+        int sum = 0;
+        for (Pointers &p : v) {
+            sum += p.visit<int>([](auto tag, auto &&) { return static_cast<int>(decltype(tag)::value) + 1; });
+        }
+        CHECK(sum == 1 + 2 + 3 + 4);
+        CHECK(v[0].holds_a() && v[1].get_p_ref() == &x && v[2].holds_b() && v[3].holds_c());
+        Pointers copy = v[2];
+        CHECK(copy.holds_b());
+    }
+    {
+        Flag f = Flag::create_on(true);
+        CHECK(f.holds_on() && f.get_on_ref());
+        f.emplace_on(false);
+        CHECK(f.holds_on() && !f.get_on_ref());
+        f.emplace_unknown();
+        CHECK(f.holds_unknown());
+        Flag g = f;
+        CHECK(g.holds_unknown());
+    }
+    {
+        int x = 1;
+        Handle h = Handle::create_valid(NonNull{&x});
+        CHECK(h.holds_valid() && h.get_valid_ref().ptr == &x);
+        h.emplace_closed();
+        CHECK(h.holds_closed());
+    }
+    {
+        Text t = Text::create_text("a string long enough to be allocated on the heap");
+        Text u = t;
+        t.emplace_none();
+        CHECK(t.holds_none() && u.holds_text());
+    }
+    return 0;
+}
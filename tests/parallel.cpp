@@ -0,0 +1,105 @@
+#include "parallel.hpp"
+
+#include "check.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+UNION(Shape
+    , (int, number)
+    , (std::string, text)
+    , (struct {}, none)
+    , (double, real)
+);
+
+int main() {
+    constexpr int count = 100003;
+    std::vector<Shape> shapes;
+    for (int i = 0; i < count; ++i) {
+        switch (i % 4) {
+        case 0:
+            shapes.push_back(Shape::create_number(i));
+            break;
+        case 1:
+            shapes.push_back(Shape::create_text(std::string(static_cast<std::size_t>(i % 7), 'x')));
+            break;
+        case 2:
+            shapes.push_back(Shape::create_none());
+            break;
+        default:
+            shapes.push_back(Shape::create_real(1.0));
+            break;
+        }
+    }
+
+    // Every element is visited exactly once, on its alternative
+    std::vector<std::atomic<int>> visits(shapes.size());
+    auto index = [&](auto const &alternative) {
+        return static_cast<std::size_t>((reinterpret_cast<std::byte const *>(&alternative) - reinterpret_cast<std::byte const *>(shapes.data())) / static_cast<std::ptrdiff_t>(sizeof(Shape)));
+    };
+    std::atomic<long long> sum{0}, length{0}, nones{0}, reals{0};
+    tu::parallel_policy<Shape> policy;
+    policy.threads = 8;
+    policy.task_cost = 500;
+    policy.cost[static_cast<std::size_t>(Shape::tag_t::text)] = 10;
+    tu::parallel_visit(shapes, tu::combined_visitor{
+        [&](auto, int &number) {
+            ++visits[index(number)];
+            sum += number;
+            number = -number;
+        },
+        [&](auto, std::string const &text) {
+            ++visits[index(text)];
+            length += static_cast<long long>(text.size());
+        },
+        // Not accepted as an alternative, so passed as the union
+        [&](Shape &shape) {
+            ++visits[index(shape)];
+            nones += shape.holds_none();
+        },
+        [&](auto, double const &real) {
+            ++visits[index(real)];
+            ++reals;
+        },
+    }, policy);
+    long long expected_sum = 0, expected_length = 0;
+    for (int i = 0; i < count; ++i) {
+        expected_sum += i % 4 == 0 ? i : 0;
+        expected_length += i % 4 == 1 ? i % 7 : 0;
+    }
+    CHECK(sum == expected_sum);
+    CHECK(length == expected_length);
+    CHECK(nones == (count + 1) / 4);
+    CHECK(reals == count / 4);
+    for (auto const &visit : visits) {
+        CHECK(visit == 1);
+    }
+    CHECK(shapes[4].get_number_ref() == -4);
+
+    std::vector<Shape> const &constant = shapes;
+    std::atomic<int> visited{0};
+    tu::parallel_visit(constant, [&](auto, auto const &) { ++visited; });
+    CHECK(visited == count);
+
+    // The first exception is rethrown after all workers stopped
+    CHECK_THROWS(std::runtime_error, tu::parallel_visit(shapes, [](auto, auto &) { throw std::runtime_error("visit failed"); }));
+    CHECK_THROWS(std::runtime_error, tu::parallel_visit(shapes, tu::combined_visitor{
+        [](auto, std::string &) { throw std::runtime_error("text"); },
+        [](auto, auto &) {},
+    }));
+
+    std::vector<Shape> empty;
+    tu::parallel_visit(empty, [](auto, auto &) { CHECK(false); });
+
+    policy.threads = 1;
+    visited = 0;
+    tu::parallel_visit(std::span(shapes).first(10), [&](auto, auto &) { ++visited; }, policy);
+    CHECK(visited == 10);
+
+#if defined(TU_FAIL_PARALLEL_VISIT)
+    tu::parallel_visit(shapes, [](tu::in_place_tag_t<Shape::tag_t::number>, int) {});
+#endif
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <string>
+
+UNION(Message
+    , (int, data)
+    , (std::string, text)
+    , (double, real)
+    , (struct {}, ping)
+    , (long, error)
+    , (char, bad)
+);
+
+// Declared after the union, before its first visit
+template<>
+struct tu::dispatch_profile<Message> {
+    static constexpr std::array<std::uint64_t, Message::alternative_count> frequencies = {1000, 300, 2, 5000, 1, 0};
+};
+
+UNION(Small
+    , (int, a)
+    , (float, b)
+);
+
+template<>
+struct tu::dispatch_profile<Small> {
+    static constexpr std::array<std::uint64_t, 2> frequencies = {1, 10};
+};
+
+// E.g. the stats of a run that never visited
+UNION(Unvisited
+    , (int, a)
+    , (float, b)
+    , (char, c)
+);
+
+template<>
+struct tu::dispatch_profile<Unvisited> {
+    static constexpr std::array<std::uint64_t, 3> frequencies = {0, 0, 0};
+};
+
+static_assert(tu::detail::profile_layout<Unvisited>::checks == 0);
+static_assert(!tu::detail::profile_layout<Unvisited>::cold(0) && !tu::detail::profile_layout<Unvisited>::cold(2));
+static_assert([] {
+    Unvisited unvisited = Unvisited::create_c('x');
+    return unvisited.visit<int>([](auto, auto value) { return static_cast<int>(value); });
+}() == 'x');
+
+using layout = tu::detail::profile_layout<Message>;
+static_assert(layout::order[0] == 3 && layout::order[1] == 0 && layout::order[2] == 1);
+static_assert(layout::checks == 3);
+static_assert(layout::cold(2) && layout::cold(4) && layout::cold(5));
+static_assert(!layout::cold(1));
+
+constexpr int evaluated() {
+    Small small = Small::create_a(3);
+    return small.visit<int>([](auto, auto value) { return static_cast<int>(value); });
+}
+
+static_assert(evaluated() == 3);
+
+struct Matcher {
+    int case_data(int const &) const {
+        return 1;
+    }
+
+    int case_text(std::string const &) const {
+        return 2;
+    }
+
+    int otherwise(Message const &message) const {
+        return 10 + static_cast<int>(message.get_tag());
+    }
+};
+
+struct MovingMatcher {
+    int case_text(std::string &&text) const {
+        std::string moved = std::move(text);
+        return static_cast<int>(moved.size());
+    }
+
+    int otherwise(Message &&) const {
+        return -1;
+    }
+};
+
+int classify(Message const &message) {
+    return MATCH(int, message
+        , CASE(data, data, { return data; })
+        , CASE(ping, ping, {
+            (void)ping;
+            return 100;
+        })
+        , OTHERWISE(other, { return -static_cast<int>(other.get_tag()); }));
+}
+
+int main() {
+    // Hot, warm and cold arms all dispatch to the right alternative
+    Message messages[] = {Message::create_data(7), Message::create_text("hey"), Message::create_real(1), Message::create_ping(), Message::create_error(4), Message::create_bad('c')};
+    int const classified[] = {7, -1, -2, 100, -4, -5};
+    for (int i = 0; i < 6; ++i) {
+        CHECK(classify(messages[i]) == classified[i]);
+        CHECK(messages[i].visit<int>([](auto tag, auto const &) { return static_cast<int>(tag.value); }) == i);
+        CHECK(std::move(messages[i]).visit<int>([](auto tag, auto &&) { return static_cast<int>(tag.value); }) == i);
+        CHECK(messages[i].match<int>(Matcher{}) == (i == 0 ? 1 : i == 1 ? 2 : 10 + i));
+        CHECK(messages[i].visit_expect<Message::tag_t::data, int>([](auto tag, auto const &) { return static_cast<int>(tag.value); }) == i);
+    }
+
+    // Rvalue arms still move
+    Message text = Message::create_text("abcd");
+    CHECK(std::move(text).match<int>(MovingMatcher{}) == 4);
+    CHECK(text.get_text_ref().empty());
+
+    Small small = Small::create_b(2.5f);
+    CHECK(small.visit<float>([](auto, auto value) { return static_cast<float>(value); }) == 2.5f);
+
+#if defined(TU_INSTRUMENT)
+    // The visits above, rendered as the specialization for the next build
+    std::string source = tu::dispatch_profile_source<Message>("Message");
+    CHECK(source.find("template<>\nstruct tu::dispatch_profile<Message> {\n") == 0);
+    CHECK(source.find("static constexpr std::array<std::uint64_t, Message::alternative_count> frequencies = {") != std::string::npos);
+    CHECK(source.find("= {5, 6, 5, 5, 5, 5};\n};\n") != std::string::npos);
+#endif
+    return 0;
+}
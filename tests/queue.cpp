@@ -0,0 +1,155 @@
+#include "queue.hpp"
+
+#include "check.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+UNION(Message
+    , (int, number)
+    , (std::string, text)
+    , (struct {}, stop)
+);
+
+inline int live = 0;
+
+struct Counted {
+    explicit Counted(int value) : value(value) {
+        ++live;
+    }
+
+    Counted(Counted &&other) noexcept : value(other.value) {
+        ++live;
+    }
+
+    ~Counted() {
+        --live;
+    }
+
+    int value;
+};
+
+UNION(Tracked
+    , (Counted, counted)
+    , (int, plain)
+);
+
+struct Throwing {
+    explicit Throwing(int value) {
+        if (value < 0) {
+            throw std::runtime_error("negative");
+        }
+    }
+};
+
+UNION(Fallible
+    , (Throwing, throwing)
+    , (int, plain)
+);
+
+// producers threads each push count messages, alternating numbers and texts; every producer's messages must arrive
+// exactly once and in the order it pushed them
+template<typename Queue>
+void exchange_messages(int producers) {
+    Queue queue(100);
+    CHECK(queue.capacity() == 128);
+    constexpr int count = 20000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p] {
+            for (int i = 0; i < count; ++i) {
+                while (!(i % 2 ? queue.template try_emplace<Message::tag_t::number>(p * count + i) : queue.template try_emplace<Message::tag_t::text>(std::to_string(p)))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::vector<int> last(static_cast<std::size_t>(producers), -1);
+    int texts = 0;
+    int received = 0;
+    bool ordered = true;
+    while (received < producers * count) {
+        std::size_t popped = queue.try_pop_n(32, tu::combined_visitor{
+            [&](tu::in_place_tag_t<Message::tag_t::number>, int number) {
+                int &previous = last[static_cast<std::size_t>(number / count)];
+                ordered = ordered && number % count > previous;
+                previous = number % count;
+            },
+            [&](tu::in_place_tag_t<Message::tag_t::text>, std::string &&text) { texts += !text.empty(); },
+            [](auto, auto &&) {},
+        });
+        if (popped == 0) {
+            std::this_thread::yield();
+        }
+        received += static_cast<int>(popped);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    CHECK(ordered);
+    CHECK(texts == producers * count / 2);
+    for (int previous : last) {
+        CHECK(previous == count - 1);
+    }
+
+    CHECK(!queue.try_pop());
+    CHECK(queue.template try_emplace<Message::tag_t::stop>());
+    CHECK(queue.try_pop()->holds_stop());
+    CHECK(queue.try_push(Message::create_text("x")));
+    CHECK(queue.try_pop()->get_text_ref() == "x");
+}
+
+// A full queue rejects messages, and messages left in it are destroyed with it
+template<typename Queue>
+void bounded() {
+    {
+        Queue queue(4);
+        for (int i = 0; i < 4; ++i) {
+            CHECK(queue.template try_emplace<Tracked::tag_t::counted>(i));
+        }
+        CHECK(!queue.template try_emplace<Tracked::tag_t::counted>(4));
+        CHECK(!queue.try_push(Tracked::create_plain(4)));
+        CHECK(live == 4);
+        int sum = 0;
+        CHECK(queue.try_pop_n(3, tu::combined_visitor{
+            [&](tu::in_place_tag_t<Tracked::tag_t::counted>, Counted &&counted) { sum += counted.value; },
+            [](auto, auto &&) {},
+        }) == 3);
+        CHECK(sum == 0 + 1 + 2);
+        CHECK(live == 1);
+        CHECK(queue.template try_emplace<Tracked::tag_t::plain>(5));
+        CHECK(queue.try_pop_n(10, [](auto, auto &&) {}) == 2);
+        CHECK(queue.try_pop_n(10, [](auto, auto &&) {}) == 0);
+        CHECK(queue.template try_emplace<Tracked::tag_t::counted>(6));
+        CHECK(live == 1);
+    }
+    CHECK(live == 0);
+}
+
+// A throwing constructor leaves no message behind
+template<typename Queue>
+void throwing() {
+    Queue queue(4);
+    CHECK_THROWS(std::runtime_error, queue.template try_emplace<Fallible::tag_t::throwing>(-1));
+    CHECK(queue.template try_emplace<Fallible::tag_t::plain>(5));
+    auto message = queue.try_pop();
+    CHECK(message.has_value());
+    CHECK(message->get_plain_ref() == 5);
+    CHECK(!queue.try_pop());
+}
+
+int main() {
+    exchange_messages<tu::spsc_ring<Message>>(1);
+    exchange_messages<tu::spsc_ring<Message, tu::cache_line>>(1);
+    exchange_messages<tu::mpsc_queue<Message>>(4);
+    exchange_messages<tu::mpsc_queue<Message, tu::cache_line>>(3);
+    static_assert(alignof(tu::detail::ring_slot<Message, tu::cache_line>) == tu::cache_line);
+
+    bounded<tu::spsc_ring<Tracked>>();
+    bounded<tu::mpsc_queue<Tracked>>();
+    throwing<tu::spsc_ring<Fallible>>();
+    throwing<tu::mpsc_queue<Fallible>>();
+    return 0;
+}
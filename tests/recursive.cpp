@@ -0,0 +1,123 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+struct Expr;
+
+UNION(Expr
+    , (int, number)
+    , (tu::rec<Expr>, negate)
+    , (tu::rec_vec<Expr>, sum)
+    , (std::string, variable)
+);
+
+int evaluate(Expr const &expr) {
+    return expr.visit_table<int>(tu::combined_visitor{
+        [](auto, int number) { return number; },
+        [](auto, tu::rec<Expr> const &operand) { return -evaluate(*operand); },
+        [](auto, tu::rec_vec<Expr> const &operands) {
+            int sum = 0;
+            for (auto const &operand : operands) {
+                sum += evaluate(operand);
+            }
+            return sum;
+        },
+        [](auto, std::string const &) { return 0; },
+    });
+}
+
+// Standard containers of the incomplete union work as well
+struct Json;
+using JsonArray = std::vector<Json>;
+
+UNION(Json
+    , (std::nullptr_t, null)
+    , (double, number)
+    , (JsonArray, array)
+);
+
+static_assert(std::is_copy_constructible_v<Expr>);
+static_assert(std::is_nothrow_move_constructible_v<Expr>);
+static_assert(std::is_same_v<std::compare_three_way_result_t<Expr>, std::partial_ordering>);
+
+Expr chain(int depth, int leaf) {
+    Expr expr = Expr::create_number(leaf);
+    for (int i = 0; i < depth; ++i) {
+        expr = Expr::create_negate(std::move(expr));
+    }
+    return expr;
+}
+
+int main() {
+    Expr sum = Expr::create_sum(tu::rec_vec<Expr>{Expr::create_number(1), Expr::create_negate(Expr::create_number(5)), Expr::create_number(10)});
+    CHECK(evaluate(sum) == 6);
+    CHECK(sum.get_sum_ref().size() == 3);
+
+    // Copies are deep
+    Expr copy = sum;
+    CHECK(copy == sum);
+    copy.get_sum_ref()[0] = Expr::create_number(2);
+    CHECK(copy != sum);
+    CHECK(sum < copy);
+    CHECK(evaluate(sum) == 6);
+    CHECK(evaluate(copy) == 7);
+
+    std::unordered_set<Expr> set{sum, copy};
+    CHECK(set.size() == 2);
+    CHECK(set.count(copy) == 1);
+
+    Expr negated = chain(2, 3);
+    CHECK(evaluate(negated) == 3);
+    CHECK(evaluate(*negated.get_negate_ref()) == -3);
+    negated.emplace_negate(Expr::create_number(4));
+    CHECK(evaluate(negated) == -4);
+
+    // Nodes come from the pool of the scope and are recycled through its free list
+    {
+        tu::node_pool<Expr> pool;
+        tu::node_scope<Expr> scope(pool);
+        CHECK(tu::node_pool<Expr>::current() == &pool);
+        Expr first = Expr::create_negate(Expr::create_number(1));
+        Expr const *node = &*first.get_negate_ref();
+        first = Expr::create_number(0);
+        Expr second = Expr::create_negate(Expr::create_number(2));
+        CHECK(&*second.get_negate_ref() == node);
+
+        Expr deep = chain(1000, 0);
+        CHECK(evaluate(deep) == 0);
+        Expr deep_copy = deep;
+        CHECK(deep_copy == deep);
+    }
+    CHECK(tu::node_pool<Expr>::current() == nullptr);
+
+    // Scopes nest
+    {
+        tu::node_pool<Expr> outer;
+        tu::node_scope<Expr> outer_scope(outer);
+        {
+            tu::node_pool<Expr> inner;
+            tu::node_scope<Expr> inner_scope(inner);
+            CHECK(tu::node_pool<Expr>::current() == &inner);
+        }
+        CHECK(tu::node_pool<Expr>::current() == &outer);
+    }
+
+    // A bulk pool frees the nodes at once
+    {
+        tu::node_pool<Expr> pool(true, 256);
+        CHECK(pool.bulk());
+        tu::node_scope<Expr> scope(pool);
+        Expr deep = chain(5000, 1);
+        CHECK(evaluate(deep) == 1);
+    }
+    CHECK(evaluate(negated) == -4);
+
+    Json json = Json::create_array(JsonArray{Json::create_number(1), Json::create_null()});
+    CHECK(json == json);
+    CHECK(json.get_array_ref().size() == 2);
+    return 0;
+}
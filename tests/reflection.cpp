@@ -0,0 +1,103 @@
+#include "serialize.hpp"
+
+#include "check.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <vector>
+
+struct NoDefault {
+    explicit NoDefault(int value) : value(value) {}
+
+    int value;
+};
+
+struct Point {
+    int x;
+    int y;
+};
+
+UNION(Record
+    , (int, id)
+    , (std::string, text)
+    , (Point, point)
+    , (NoDefault, fixed)
+    , (BOXED(Point), far)
+    , (struct {}, empty)
+);
+
+UNION(Node
+    , (int, leaf)
+    , (tu::rec<Node>, next)
+);
+
+static_assert(Record::tag_count == 6);
+static_assert(Record::union_name == "Record" && Record::tag_names[2] == "point");
+static_assert(Record::field_types[1] == "std::string" && Record::field_types[4] == "tu::boxed<Point>");
+static_assert(Record::alternative_sizes[0] == sizeof(int) && Record::alternative_sizes[2] == sizeof(Point));
+static_assert(Record::alternative_sizes[4] == sizeof(tu::boxed<Point>));
+
+// The encoding of tu::serializer, i.e. what tu::serialize writes after the tag
+template<typename T>
+std::vector<std::byte> encode(T const &value) {
+    std::vector<std::byte> bytes(tu::serializer<T>::size(value));
+    tu::serializer<T>::store(value, bytes.data());
+    return bytes;
+}
+
+void test_create_default() {
+    std::optional<Record> text = Record::create_default(Record::tag_t::text);
+    CHECK(text && text->holds_text() && text->get_text_ref().empty());
+    CHECK(!Record::create_default(Record::tag_t::fixed));
+    CHECK(!Record::create_default(static_cast<Record::tag_t>(17)));
+    CHECK(!Node::create_default(Node::tag_t::next));
+}
+
+void test_emplace_from_bytes() {
+    Record record = Record::create_id(1);
+    std::vector<std::byte> point = encode(Point{3, 4});
+    CHECK(record.emplace_from_bytes(Record::tag_t::point, point) && record.get_point_ref().y == 4);
+    CHECK(record.emplace_from_bytes(Record::tag_t::far, point) && record.get_far_ref().x == 3);
+    CHECK(record.emplace_from_bytes(Record::tag_t::fixed, encode(NoDefault(9))) && record.get_fixed_ref().value == 9);
+
+    // Non-trivially copyable alternatives are read with their serializer, and empty ones need no bytes
+    CHECK(record.emplace_from_bytes(Record::tag_t::text, encode(std::string("hello"))));
+    CHECK(record.get_text_ref() == "hello");
+    CHECK(record.emplace_from_bytes(Record::tag_t::empty, {}) && record.holds_empty());
+
+    // Bytes after the alternative are ignored
+    std::vector<std::byte> padded = encode(7);
+    padded.resize(16);
+    CHECK(record.emplace_from_bytes(Record::tag_t::id, padded) && record.get_id_ref() == 7);
+
+    // Truncated input and out-of-range tags leave the union unchanged
+    CHECK(!record.emplace_from_bytes(Record::tag_t::point, std::span(point).first(4)));
+    std::vector<std::byte> text = encode(std::string("hello"));
+    CHECK(!record.emplace_from_bytes(Record::tag_t::text, std::span(text).first(text.size() - 1)));
+    CHECK(!record.emplace_from_bytes(static_cast<Record::tag_t>(6), point));
+    CHECK(record.holds_id() && record.get_id_ref() == 7);
+}
+
+void test_create_n() {
+    std::vector<Record> column;
+    std::optional<std::back_insert_iterator<std::vector<Record>>> end = Record::create_n(Record::tag_t::id, 5, std::back_inserter(column));
+    CHECK(end.has_value());
+    CHECK(column.size() == 5 && column[4].holds_id() && column[4].get_id_ref() == 0);
+
+    Record array[3] = {Record::create_id(1), Record::create_id(2), Record::create_id(3)};
+    std::optional<Record *> last = Record::create_n(Record::tag_t::point, 2, array);
+    CHECK(last == array + 2 && array[1].holds_point() && array[2].holds_id());
+    CHECK(Record::create_n(Record::tag_t::empty, 0, array) == array);
+
+    // Alternatives without a default constructor and out-of-range tags write nothing
+    CHECK(!Record::create_n(Record::tag_t::fixed, 5, std::back_inserter(column)));
+    CHECK(!Record::create_n(static_cast<Record::tag_t>(6), 5, std::back_inserter(column)));
+    CHECK(column.size() == 5);
+}
+
+int main() {
+    test_create_default();
+    test_emplace_from_bytes();
+    test_create_n();
+}
@@ -0,0 +1,279 @@
+#include "relocate.hpp"
+
+#include "check.hpp"
+
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+
+UNION(Item
+    , (int, number)
+    , (std::unique_ptr<int>, owned)
+);
+
+UNION(Labelled
+    , (int, number)
+    , (std::string, label)
+);
+
+static_assert(tu::is_trivially_relocatable_v<Item>);
+static_assert(!tu::is_trivially_relocatable_v<Labelled>);
+
+// Copyable, with a move constructor that may throw, so that relocation copies; the copy throws once copies_left runs out
+inline int copies_left = 1000;
+inline int live = 0;
+
+struct Fragile {
+    explicit Fragile(int value) : value(value) {
+        ++live;
+    }
+
+    Fragile(Fragile const &other) : value(other.value) {
+        if (copies_left-- == 0) {
+            throw std::runtime_error("copy");
+        }
+        ++live;
+    }
+
+    Fragile(Fragile &&other) noexcept(false) : value(std::exchange(other.value, -1)) {
+        ++live;
+    }
+
+    Fragile &operator=(Fragile const &) = default;
+
+    ~Fragile() {
+        --live;
+    }
+
+    int value;
+};
+
+struct Stats {
+    int allocations = 0;
+    int constructs = 0;
+    int destroys = 0;
+};
+
+// Allocator identified by id that counts its calls and propagates as Propagate says
+template<typename T, bool Propagate>
+struct Tracking {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_swap = std::bool_constant<Propagate>;
+    using is_always_equal = std::false_type;
+
+    template<typename U>
+    struct rebind {
+        using other = Tracking<U, Propagate>;
+    };
+
+    Tracking(Stats &stats, int id) noexcept : stats(&stats), id(id) {}
+
+    T *allocate(std::size_t count) {
+        ++stats->allocations;
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T *storage, std::size_t count) noexcept {
+        --stats->allocations;
+        std::allocator<T>().deallocate(storage, count);
+    }
+
+    template<typename... Args>
+    void construct(T *at, Args &&...args) {
+        std::construct_at(at, std::forward<Args>(args)...);
+        ++stats->constructs;
+    }
+
+    void destroy(T *at) noexcept {
+        ++stats->destroys;
+        std::destroy_at(at);
+    }
+
+    friend bool operator==(Tracking const &a, Tracking const &b) noexcept {
+        return a.id == b.id;
+    }
+
+    Stats *stats;
+    int id;
+};
+
+template<bool Propagate>
+using tracked_vector = tu::vector<Item, Tracking<Item, Propagate>>;
+
+static_assert(std::is_nothrow_move_assignable_v<tu::vector<Item>>);
+static_assert(std::is_nothrow_move_assignable_v<tracked_vector<true>>);
+static_assert(!std::is_nothrow_move_assignable_v<tracked_vector<false>>);
+static_assert(!std::is_nothrow_move_assignable_v<tu::vector<Item, std::pmr::polymorphic_allocator<Item>>>);
+
+void test_relocate() {
+    // Trivially relocatable: the bytes move and the source is not touched again
+    alignas(Item) std::byte source[2 * sizeof(Item)];
+    alignas(Item) std::byte dest[2 * sizeof(Item)];
+    auto *items = reinterpret_cast<Item *>(source);
+    std::construct_at(items, Item::create_number(1));
+    std::construct_at(items + 1, Item::create_owned(std::make_unique<int>(2)));
+    auto *moved = reinterpret_cast<Item *>(dest);
+    CHECK(tu::relocate(items, items + 2, moved) == moved + 2);
+    CHECK(moved[0].get_number_ref() == 1 && *moved[1].get_owned_ref() == 2);
+    std::destroy(moved, moved + 2);
+
+    // A throwing copy leaves every source element alive and unchanged, and destroys the copies made so far
+    alignas(Fragile) std::byte fragile_source[3 * sizeof(Fragile)];
+    alignas(Fragile) std::byte fragile_dest[3 * sizeof(Fragile)];
+    auto *fragile = reinterpret_cast<Fragile *>(fragile_source);
+    for (int i = 0; i < 3; ++i) {
+        std::construct_at(fragile + i, i);
+    }
+    copies_left = 2;
+    CHECK_THROWS(std::runtime_error, tu::relocate(fragile, fragile + 3, reinterpret_cast<Fragile *>(fragile_dest)));
+    CHECK(live == 3);
+    CHECK(fragile[0].value == 0 && fragile[1].value == 1 && fragile[2].value == 2);
+    copies_left = 1000;
+    auto *relocated = reinterpret_cast<Fragile *>(fragile_dest);
+    tu::relocate(fragile, fragile + 3, relocated);
+    CHECK(live == 3 && relocated[2].value == 2);
+    std::destroy(relocated, relocated + 3);
+    CHECK(live == 0);
+}
+
+void test_growth() {
+    tu::vector<Item> items;
+    for (int i = 0; i < 100; ++i) {
+        items.emplace_back(Item::create_owned(std::make_unique<int>(i)));
+    }
+    CHECK(items.size() == 100 && *items[99].get_owned_ref() == 99);
+    items.erase(items.begin());
+    CHECK(items.size() == 99 && *items.front().get_owned_ref() == 1);
+    items.shrink_to_fit();
+    CHECK(items.capacity() == 99);
+
+    // Not trivially relocatable: moved element by element
+    tu::vector<Labelled> labels;
+    for (int i = 0; i < 10; ++i) {
+        labels.emplace_back(Labelled::create_label(std::string(32, static_cast<char>('a' + i))));
+    }
+    labels.erase(labels.begin());
+    CHECK(labels.size() == 9 && labels.front().get_label_ref()[0] == 'b' && labels.back().get_label_ref()[0] == 'j');
+
+    // Growing a vector of Fragile copies, and a throwing copy leaves the vector as it was
+    {
+        tu::vector<Fragile> fragile;
+        for (int i = 0; i < 4; ++i) {
+            fragile.emplace_back(i);
+        }
+        copies_left = 2;
+        CHECK_THROWS(std::runtime_error, fragile.emplace_back(4));
+        CHECK(fragile.size() == 4 && fragile.capacity() == 4 && live == 4);
+        CHECK(fragile[0].value == 0 && fragile[3].value == 3);
+        copies_left = 1000;
+    }
+    CHECK(live == 0);
+}
+
+void test_allocator() {
+    Stats stats;
+    Tracking<Item, false> allocator(stats, 1);
+    {
+        tracked_vector<false> items(allocator);
+        for (int i = 0; i < 5; ++i) {
+            items.emplace_back(Item::create_number(i));
+        }
+        // Growing from 4 to 8: every element goes through construct and destroy, as the allocator customizes them
+        CHECK(stats.allocations == 1);
+        CHECK(stats.constructs == 9 && stats.destroys == 4);
+        items.pop_back();
+        items.erase(items.begin());
+        CHECK(stats.destroys == 6);
+        items.clear();
+        CHECK(stats.constructs - stats.destroys == 0);
+    }
+    CHECK(stats.allocations == 0);
+}
+
+void test_throwing_copy() {
+    Stats stats;
+    Tracking<Fragile, false> allocator(stats, 1);
+    {
+        tu::vector<Fragile, Tracking<Fragile, false>> fragile(allocator);
+        for (int i = 0; i < 3; ++i) {
+            fragile.emplace_back(i);
+        }
+        copies_left = 1;
+        // The copy allocated its storage and copied one element before the second copy threw
+        CHECK_THROWS(std::runtime_error, tu::vector<Fragile, Tracking<Fragile, false>>{fragile});
+        CHECK(stats.allocations == 1 && live == 3);
+        copies_left = 1;
+        tu::vector<Fragile, Tracking<Fragile, false>> other(allocator);
+        other.emplace_back(7);
+        CHECK_THROWS(std::runtime_error, other = fragile);
+        CHECK(other.size() == 1 && other[0].value == 7);
+        CHECK(stats.allocations == 2 && live == 4);
+        copies_left = 1000;
+        other = fragile;
+        CHECK(other.size() == 3 && other[2].value == 2);
+    }
+    CHECK(stats.allocations == 0 && live == 0);
+}
+
+template<bool Propagate>
+void test_propagation() {
+    Stats stats;
+    Tracking<Labelled, Propagate> first(stats, 1), second(stats, 2);
+    tu::vector<Labelled, Tracking<Labelled, Propagate>> a(first), b(second);
+    a.emplace_back(Labelled::create_number(1));
+    b.emplace_back(Labelled::create_number(2));
+    b.emplace_back(Labelled::create_number(3));
+
+    a = b;
+    CHECK(a.size() == 2 && a[1].get_number_ref() == 3);
+    CHECK(a.get_allocator().id == (Propagate ? 2 : 1));
+
+    tu::vector<Labelled, Tracking<Labelled, Propagate>> c(first);
+    c.emplace_back(Labelled::create_number(4));
+    Labelled const *storage = c.data();
+    b = std::move(c);
+    CHECK(b.size() == 1 && b[0].get_number_ref() == 4);
+    // Storage is adopted if the allocator propagates, and the elements are moved into storage of b's allocator otherwise
+    CHECK(b.get_allocator().id == (Propagate ? 1 : 2));
+    CHECK((b.data() == storage) == Propagate);
+
+    if constexpr (Propagate) {
+        tu::vector<Labelled, Tracking<Labelled, Propagate>> d(second);
+        a.swap(d);
+        CHECK(a.empty() && a.get_allocator().id == 2 && d.size() == 2 && d.get_allocator().id == 2);
+    }
+}
+
+void test_pmr() {
+    using pmr_vector = tu::vector<Item, std::pmr::polymorphic_allocator<Item>>;
+    std::pmr::monotonic_buffer_resource first_resource, second_resource;
+    pmr_vector a(&first_resource), b(&second_resource), c(&first_resource);
+    a.emplace_back(Item::create_owned(std::make_unique<int>(1)));
+    b.emplace_back(Item::create_owned(std::make_unique<int>(2)));
+    c.emplace_back(Item::create_owned(std::make_unique<int>(3)));
+
+    // Unequal resources: the element is moved into storage from a's resource
+    a = std::move(b);
+    CHECK(a.size() == 1 && *a[0].get_owned_ref() == 2);
+    CHECK(a.get_allocator().resource() == &first_resource);
+
+    // Equal resources: storage is adopted, and swapping keeps the allocators
+    Item const *storage = c.data();
+    a.swap(c);
+    CHECK(a.data() == storage && *c[0].get_owned_ref() == 2);
+    a = std::move(c);
+    CHECK(*a[0].get_owned_ref() == 2);
+    CHECK(a.get_allocator().resource() == &first_resource);
+}
+
+int main() {
+    test_relocate();
+    test_growth();
+    test_allocator();
+    test_throwing_copy();
+    test_propagation<true>();
+    test_propagation<false>();
+    test_pmr();
+}
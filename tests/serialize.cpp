@@ -0,0 +1,163 @@
+#include "serialize.hpp"
+
+#include "check.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Not trivially copyable, encoded by its own serializer as one byte
+struct Flag {
+    std::unique_ptr<bool> value;
+};
+
+template<>
+struct tu::serializer<Flag> {
+    static constexpr bool trivial = false;
+
+    static std::size_t size(Flag const &) noexcept {
+        return 1;
+    }
+
+    static std::byte *store(Flag const &flag, std::byte *out) noexcept {
+        *out = std::byte(*flag.value ? 1 : 0);
+        return out + 1;
+    }
+
+    static std::optional<Flag> load(std::span<std::byte const> &in) {
+        if (in.empty() || static_cast<unsigned>(in[0]) > 1) {
+            return std::nullopt;
+        }
+        Flag flag{std::make_unique<bool>(in[0] == std::byte(1))};
+        in = in.subspan(1);
+        return flag;
+    }
+};
+
+UNION(Inner
+    , (int, number)
+    , (bool, on)
+);
+
+// The tag lives in the bytes of value that are neither 0 nor 1
+UNION(Maybe
+    , (bool, value)
+    , (struct {}, none)
+);
+
+UNION(Msg
+    , (std::int64_t, id)
+    , (std::string, text)
+    , (struct { double x; double y; }, point)
+    , (struct {}, ping)
+    , (std::vector<int>, ints)
+    , (char, c)
+    , (Flag, flag)
+    , (bool, on)
+    , (Inner, inner)
+    , (Maybe, maybe)
+);
+
+alignas(Msg) std::byte buffer[256];
+
+std::span<std::byte const> written(std::size_t size) {
+    return std::span<std::byte const>(buffer, size);
+}
+
+// Serializes value, checks that it reads back as expected and that no proper prefix of the encoding deserializes
+template<typename Check>
+std::size_t round_trip(Msg const &value, Check &&check) {
+    std::size_t size = tu::serialize(value, buffer);
+    CHECK(size != 0);
+    CHECK(size == tu::serialized_size(value));
+    auto loaded = tu::deserialize<Msg>(written(size));
+    CHECK(loaded.has_value());
+    CHECK(loaded->get_tag() == value.get_tag());
+    check(*loaded);
+    CHECK(tu::view<Msg>(written(size)).valid());
+    for (std::size_t prefix = 0; prefix < size; ++prefix) {
+        CHECK(!tu::deserialize<Msg>(written(prefix)));
+        CHECK(!tu::view<Msg>(written(prefix)).valid());
+    }
+    return size;
+}
+
+int main() {
+    // Trivial alternatives are padded to their alignment, others follow the tag directly
+    CHECK(round_trip(Msg::create_id(-7), [](Msg const &m) { CHECK(m.get_id_ref() == -7); }) == 8 + 8);
+    CHECK(round_trip(Msg::create_point(1.5, 2.5), [](Msg const &m) { CHECK(m.get_point_ref().y == 2.5); }) == 8 + 16);
+    CHECK(round_trip(Msg::create_ping(), [](Msg const &) {}) == 1);
+    CHECK(round_trip(Msg::create_c('z'), [](Msg const &m) { CHECK(m.get_c_ref() == 'z'); }) == 2);
+    CHECK(round_trip(Msg::create_text("hello"), [](Msg const &m) { CHECK(m.get_text_ref() == "hello"); }) == 1 + 8 + 5);
+    CHECK(round_trip(Msg::create_text(""), [](Msg const &m) { CHECK(m.get_text_ref().empty()); }) == 1 + 8);
+    CHECK(round_trip(Msg::create_ints(std::vector<int>{1, 2, 3}), [](Msg const &m) { CHECK((m.get_ints_ref() == std::vector<int>{1, 2, 3})); }) == 1 + 8 + 12);
+    CHECK(round_trip(Msg::create_flag(Flag{std::make_unique<bool>(true)}), [](Msg const &m) { CHECK(*m.get_flag_ref().value); }) == 2);
+
+    // Views read trivial alternatives in place
+    std::size_t size = tu::serialize(Msg::create_point(3.0, 4.0), buffer);
+    tu::view<Msg> point(written(size));
+    CHECK(point.holds_point());
+    CHECK(point.get_id_ptr() == nullptr);
+    CHECK(point.get_point_ptr() == reinterpret_cast<void const *>(buffer + 8));
+    CHECK(point.get_point_ref().x == 3.0);
+    CHECK(point.load().get_point_ref().y == 4.0);
+
+    size = tu::serialize(Msg::create_text("viewed"), buffer);
+    tu::view<Msg> text(written(size));
+    CHECK(text.holds_text());
+    CHECK(text.load().get_text_ref() == "viewed");
+
+    // Too small an output buffer writes nothing
+    CHECK(tu::serialize(Msg::create_text("hello"), std::span<std::byte>(buffer, 4)) == 0);
+    CHECK(tu::serialize(Msg::create_id(1), std::span<std::byte>(buffer, 15)) == 0);
+
+    // Malformed input
+    buffer[0] = std::byte(99);
+    CHECK(!tu::deserialize<Msg>(written(16)));
+    CHECK(!tu::view<Msg>(written(16)).valid());
+
+    buffer[0] = std::byte(static_cast<unsigned char>(Msg::tag_t::text));
+    std::uint64_t huge = ~std::uint64_t(0);
+    std::memcpy(buffer + 1, &huge, sizeof(huge));
+    CHECK(!tu::deserialize<Msg>(written(64)));
+    CHECK(!tu::view<Msg>(written(64)).valid());
+
+    buffer[0] = std::byte(static_cast<unsigned char>(Msg::tag_t::flag));
+    buffer[1] = std::byte(2);
+    CHECK(!tu::deserialize<Msg>(written(2)));
+    CHECK(!tu::view<Msg>(written(2)).valid());
+
+    // Trivially copyable alternatives are checked for invalid bools and nested tags, also in place and by emplace_from_bytes
+    CHECK(round_trip(Msg::create_on(true), [](Msg const &m) { CHECK(m.get_on_ref()); }) == 2);
+    CHECK(round_trip(Msg::create_inner(Inner::create_on(true)), [](Msg const &m) { CHECK(m.get_inner_ref().get_on_ref()); }) == 4 + sizeof(Inner));
+    CHECK(round_trip(Msg::create_maybe(Maybe::create_none()), [](Msg const &m) { CHECK(m.get_maybe_ref().holds_none()); }) == 2);
+    static_assert(Maybe::layout_info().tag_size == 0);
+
+    auto rejected = [](Msg::tag_t tag, std::size_t size, std::size_t payload) {
+        Msg msg = Msg::create_id(1);
+        CHECK(!tu::deserialize<Msg>(written(size)));
+        CHECK(!tu::view<Msg>(written(size)).valid());
+        CHECK(!msg.emplace_from_bytes(tag, written(size).subspan(payload)));
+        CHECK(msg.holds_id());
+    };
+    size = tu::serialize(Msg::create_on(true), buffer);
+    buffer[1] = std::byte(0x42);
+    rejected(Msg::tag_t::on, size, 1);
+
+    size = tu::serialize(Msg::create_inner(Inner::create_number(5)), buffer);
+    buffer[4 + Inner::layout_info().tag_offset] = std::byte(0x7f);
+    rejected(Msg::tag_t::inner, size, 4);
+
+    size = tu::serialize(Msg::create_inner(Inner::create_on(false)), buffer);
+    buffer[4 + Inner::layout_info().storage_offset] = std::byte(0x42);
+    rejected(Msg::tag_t::inner, size, 4);
+
+    size = tu::serialize(Msg::create_maybe(Maybe::create_value(true)), buffer);
+    buffer[1] = std::byte(0x7f);
+    rejected(Msg::tag_t::maybe, size, 1);
+    buffer[1] = std::byte(2);
+    CHECK(tu::deserialize<Msg>(written(size))->get_maybe_ref().holds_none());
+    return 0;
+}
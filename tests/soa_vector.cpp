@@ -0,0 +1,79 @@
+#include "soa_vector.hpp"
+
+#include "check.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+struct Throwing {
+    explicit Throwing(bool fail) {
+        if (fail) {
+            throw std::runtime_error("construction failed");
+        }
+    }
+};
+
+UNION(Shape
+    , (double, circle)
+    , (struct { double w; double h; }, rect)
+    , (std::string, label)
+    , (struct {}, empty)
+    , (Throwing, throwing)
+);
+
+int main() {
+    tu::soa_vector<Shape> v;
+    v.push_back_circle(1.0);
+    v.push_back_rect(2.0, 3.0);
+    v.push_back_label("hi");
+    v.push_back(Shape::create_circle(2.0));
+    Shape moved = Shape::create_label("moved");
+    v.push_back(std::move(moved));
+    v.emplace_back<Shape::tag_t::empty>();
+
+    CHECK(v.size() == 6);
+    CHECK(v.count<Shape::tag_t::circle>() == 2);
+    CHECK(v.count<Shape::tag_t::label>() == 2);
+    CHECK(std::count(v.tags().begin(), v.tags().end(), Shape::tag_t::label) == 2);
+    CHECK(v.tags()[5] == Shape::tag_t::empty);
+    CHECK(v.column<Shape::tag_t::circle>().size() == 2);
+
+    CHECK(v[1].holds_rect() && v[1].get_rect_ref().h == 3.0);
+    CHECK(v[0].get_rect_ptr() == nullptr);
+    *v[3].get_circle_ptr() = 5.0;
+    CHECK(v.column<Shape::tag_t::circle>()[1] == 5.0);
+
+    double sum = 0;
+    v.for_each<Shape::tag_t::circle>([&](double d) { sum += d; });
+    CHECK(sum == 6.0);
+    v.for_each<Shape::tag_t::circle>([](double &d) { d *= 2; });
+    CHECK(v[0].get_circle_ref() == 2.0);
+
+    auto const &cv = v;
+    static_assert(std::is_same_v<decltype(cv[4].get_label_ref()), std::string const &>);
+    CHECK(cv[4].get_label_ref() == "moved");
+    Shape copy = cv[4].load();
+    CHECK(copy.holds_label() && copy.get_label_ref() == "moved");
+    CHECK(v.load(1).get_rect_ref().w == 2.0);
+
+    // A throwing constructor leaves the vector unchanged
+    CHECK_THROWS(std::runtime_error, v.push_back_throwing(true));
+    CHECK(v.size() == 6);
+    CHECK(v.count<Shape::tag_t::throwing>() == 0);
+    v.push_back_circle(7.0);
+    CHECK(v[6].get_circle_ref() == 7.0);
+
+    v.pop_back();
+    v.pop_back();
+    v.pop_back();
+    CHECK(v.size() == 4);
+    CHECK(v.count<Shape::tag_t::label>() == 1);
+    CHECK(v.count<Shape::tag_t::empty>() == 0);
+    CHECK(v[3].get_circle_ref() == 10.0);
+
+    v.clear();
+    CHECK(v.empty());
+    CHECK(v.count<Shape::tag_t::circle>() == 0);
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "tag_scan.hpp"
+
+#include "check.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+UNION(Small
+    , (int, a)
+    , (int, b)
+    , (int, c)
+);
+
+// More alternatives than the SIMD histogram handles
+UNION(Large
+    , (int, f0), (int, f1), (int, f2), (int, f3), (int, f4), (int, f5), (int, f6), (int, f7), (int, f8), (int, f9)
+    , (int, f10), (int, f11), (int, f12), (int, f13), (int, f14), (int, f15), (int, f16), (int, f17), (int, f18), (int, f19)
+);
+
+enum class Wide : std::uint16_t { x, y, z };
+
+// Compares every kernel with a scalar loop over n random tags, which covers whole blocks and tails of each width
+template<typename Union>
+void check_against_scalar(std::size_t n, unsigned seed) {
+    using tag_t = typename Union::tag_t;
+    std::mt19937 rng(seed);
+    std::vector<tag_t> tags(n);
+    for (auto &tag : tags) {
+        tag = static_cast<tag_t>(rng() % Union::alternative_count);
+    }
+    std::span<tag_t const> view(tags);
+    auto histogram = tu::tag_histogram<Union>(view);
+    for (std::size_t bin = 0; bin < Union::alternative_count; ++bin) {
+        auto tag = static_cast<tag_t>(bin);
+        std::size_t count = 0;
+        for (auto t : tags) {
+            count += t == tag;
+        }
+        CHECK(histogram[bin] == count);
+        CHECK(tu::count_tag(view, tag) == count);
+
+        std::vector<std::size_t> indices(n);
+        CHECK(tu::partition_by_tag(view, tag, indices) == count);
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (tags[i] == tag) {
+                CHECK(indices[j++] == i);
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (tags[i] != tag) {
+                CHECK(indices[j++] == i);
+            }
+        }
+    }
+    std::size_t first = 0;
+    while (first < n && tags[first] != static_cast<tag_t>(1)) {
+        ++first;
+    }
+    CHECK(tu::find_first<static_cast<tag_t>(1)>(view) == first);
+}
+
+int main() {
+    for (std::size_t n : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 200, 1000}) {
+        check_against_scalar<Small>(n, static_cast<unsigned>(n));
+        check_against_scalar<Large>(n, static_cast<unsigned>(n + 1));
+    }
+
+    // Past the first blocks, and absent
+    std::vector<Small::tag_t> rare(500, Small::tag_t::a);
+    rare[470] = Small::tag_t::c;
+    CHECK(tu::find_first<Small::tag_t::c>(std::span<Small::tag_t const>(rare)) == 470);
+    CHECK(tu::find_first<Small::tag_t::b>(std::span<Small::tag_t const>(rare)) == rare.size());
+
+    // Tags wider than a byte take the scalar path
+    std::vector<Wide> wide = {Wide::x, Wide::z, Wide::z, Wide::y};
+    CHECK(tu::count_tag(std::span<Wide const>(wide), Wide::z) == 2);
+    CHECK(tu::find_first<Wide::y>(std::span<Wide const>(wide)) == 3);
+    std::vector<std::size_t> indices(wide.size());
+    CHECK(tu::partition_by_tag(std::span<Wide const>(wide), Wide::z, indices) == 2);
+    CHECK((indices == std::vector<std::size_t>{1, 2, 0, 3}));
+    return 0;
+}
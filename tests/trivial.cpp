@@ -0,0 +1,112 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+UNION(Pod
+    , (int, index)
+    , (int, value)
+    , (struct { int x; int y; }, point)
+);
+
+UNION(MyUnion
+    , (int, index)
+    , (std::string, name)
+);
+
+UNION(NonCopyable
+    , (std::unique_ptr<int>, ptr)
+    , (std::string, name)
+);
+
+template<typename T>
+UNION(Option
+    , (T, some)
+    , (struct {}, none)
+);
+
+// Trivially destructible, but copied by a user-provided constructor
+struct Counted {
+    Counted() = default;
+    Counted(Counted const &) noexcept { ++copies; }
+    Counted &operator=(Counted const &) = default;
+
+    static inline int copies = 0;
+};
+
+UNION(Mixed
+    , (int, number)
+    , (Counted, counted)
+);
+
+static_assert(std::is_trivially_copyable_v<Pod>);
+static_assert(std::is_trivially_copy_constructible_v<Pod>);
+static_assert(std::is_trivially_move_constructible_v<Pod>);
+static_assert(std::is_trivially_copy_assignable_v<Pod>);
+static_assert(std::is_trivially_move_assignable_v<Pod>);
+static_assert(std::is_trivially_destructible_v<Pod>);
+
+static_assert(!std::is_trivially_copyable_v<MyUnion>);
+static_assert(!std::is_trivially_destructible_v<MyUnion>);
+static_assert(std::is_copy_constructible_v<MyUnion>);
+static_assert(std::is_copy_assignable_v<MyUnion>);
+
+static_assert(std::is_trivially_destructible_v<Mixed>);
+static_assert(!std::is_trivially_copy_constructible_v<Mixed>);
+// Assigning a different alternative copy constructs it
+static_assert(!std::is_trivially_copy_assignable_v<Mixed>);
+
+static_assert(!std::is_copy_constructible_v<NonCopyable>);
+static_assert(!std::is_copy_assignable_v<NonCopyable>);
+static_assert(std::is_move_constructible_v<NonCopyable>);
+static_assert(std::is_move_assignable_v<NonCopyable>);
+
+static_assert(std::is_trivially_copyable_v<Option<int>>);
+static_assert(std::is_trivially_copyable_v<Option<int *>>);
+static_assert(!std::is_trivially_copyable_v<Option<std::string>>);
+
+int main() {
+    {
+        Pod a = Pod::create_point(1, 2);
+        Pod b = Pod::create_index(0);
+        std::memcpy(static_cast<void *>(&b), &a, sizeof(Pod));
+        CHECK(b.holds_point());
+        CHECK(b.get_point_ref().x == 1 && b.get_point_ref().y == 2);
+    }
+    {
+        std::vector<Pod> pods;
+        for (int i = 0; i < 1000; ++i) {
+            pods.push_back(Pod::create_value(i));
+        }
+        CHECK(pods[500].get_value_ref() == 500);
+    }
+    {
+        MyUnion a = MyUnion::create_name("a string long enough to be allocated on the heap");
+        MyUnion b = a;
+        CHECK(b.get_name_ref() == a.get_name_ref());
+        CHECK(b.get_name_ref().data() != a.get_name_ref().data());
+        b = MyUnion::create_index(3);
+        CHECK(b.holds_index() && b.get_index_ref() == 3);
+        b = a;
+        CHECK(b.holds_name() && b.get_name_ref() == a.get_name_ref());
+    }
+    {
+        Mixed a = Mixed::create_counted();
+        Counted::copies = 0;
+        Mixed b = a;
+        CHECK(b.holds_counted());
+        CHECK(Counted::copies == 1);
+    }
+    {
+        NonCopyable a = NonCopyable::create_ptr(std::make_unique<int>(5));
+        NonCopyable b = std::move(a);
+        CHECK(*b.get_ptr_ref() == 5);
+        b = NonCopyable::create_name("x");
+        CHECK(b.holds_name());
+    }
+    return 0;
+}
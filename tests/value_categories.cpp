@@ -0,0 +1,94 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <string>
+
+UNION(Value
+    , (std::string, text)
+    , (int, number)
+);
+
+// Keeps the methods of the union, called on a derived object
+struct Derived : Value {
+    using Value::Value;
+
+    Derived(Value value) : Value(std::move(value)) {}
+};
+
+enum class category { lvalue, const_lvalue, rvalue, const_rvalue };
+
+template<typename T>
+constexpr category category_of() {
+    if constexpr (std::is_lvalue_reference_v<T>) {
+        return std::is_const_v<std::remove_reference_t<T>> ? category::const_lvalue : category::lvalue;
+    } else {
+        return std::is_const_v<std::remove_reference_t<T>> ? category::const_rvalue : category::rvalue;
+    }
+}
+
+struct CaseMatcher {
+    template<typename Text>
+    category case_text(Text &&) const {
+        return category_of<Text &&>();
+    }
+
+    category otherwise(auto &&) const {
+        return category::lvalue;
+    }
+};
+
+// otherwise gets the union itself
+struct OtherwiseMatcher {
+    template<typename Union>
+    category otherwise(Union &&) const {
+        return category_of<Union &&>();
+    }
+};
+
+// Which reference the arms of each method receive, for an object expression of type Self
+template<typename Self>
+void check_methods(category expected) {
+    using tag = Value::tag_t;
+    using object_t = std::remove_cvref_t<Self>;
+    auto object = [] { return object_t(Value::create_text("text")); };
+    auto visitor = [](auto, auto &&alternative) { return category_of<decltype(alternative)>(); };
+
+    object_t a = object();
+    CHECK(category_of<decltype(static_cast<Self &&>(a).template get_ref<tag::text>())>() == expected);
+    CHECK(category_of<decltype(static_cast<Self &&>(a).get_text_ref())>() == expected);
+    CHECK(static_cast<Self &&>(a).get_text_ref() == "text");
+
+    object_t b = object();
+    CHECK(static_cast<Self &&>(b).template visit<category>(visitor) == expected);
+    object_t c = object();
+    CHECK(static_cast<Self &&>(c).template visit_table<category>(visitor) == expected);
+    object_t d = object();
+    CHECK((static_cast<Self &&>(d).template visit_expect<tag::text, category>(visitor)) == expected);
+    object_t e = object();
+    CHECK((static_cast<Self &&>(e).template visit_expect<tag::number, category>(visitor)) == expected);
+    object_t f = object();
+    object_t g = object();
+    CHECK(static_cast<Self &&>(f).template match<category>(CaseMatcher{}) == expected);
+    CHECK(static_cast<Self &&>(g).template match<category>(OtherwiseMatcher{}) == expected);
+}
+
+int main() {
+    check_methods<Value &>(category::lvalue);
+    check_methods<Value const &>(category::const_lvalue);
+    check_methods<Value>(category::rvalue);
+    check_methods<Value const>(category::const_rvalue);
+    check_methods<Derived &>(category::lvalue);
+    check_methods<Derived const &>(category::const_lvalue);
+    check_methods<Derived>(category::rvalue);
+
+    // Visiting an rvalue moves out of it
+    Value value = Value::create_text("a string long enough to be allocated on the heap");
+    std::string moved = std::move(value).visit<std::string>(tu::combined_visitor{
+        [](auto, std::string &&text) { return std::move(text); },
+        [](auto, int) { return std::string(); },
+    });
+    CHECK(moved == "a string long enough to be allocated on the heap");
+    CHECK(value.get_text_ref().empty());
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "tagged_union.hpp"
+
+#include "check.hpp"
+
+#include <string>
+
+UNION(MyUnion
+    , (int, index)
+    , (int, value)
+    , (std::string, name)
+    , (struct { int x; int y; }, point)
+);
+
+// Handles index and name, the latter differently for rvalues, and the other alternatives through the union
+struct Visitor {
+    int operator()(tu::in_place_tag_t<MyUnion::tag_t::index>, int const &index) const {
+        return index;
+    }
+
+    int operator()(tu::in_place_tag_t<MyUnion::tag_t::name>, std::string const &name) const {
+        return static_cast<int>(name.size());
+    }
+
+    int operator()(tu::in_place_tag_t<MyUnion::tag_t::name>, std::string &&name) const {
+        return static_cast<int>(name.size()) * 100;
+    }
+
+    int operator()(MyUnion const &) const {
+        return -1;
+    }
+};
+
+int main() {
+    MyUnion name = MyUnion::create_name("abc");
+    MyUnion const index = MyUnion::create_index(7);
+
+    CHECK(name.visit_table<int>(Visitor{}) == 3);
+    CHECK(std::move(name).visit_table<int>(Visitor{}) == 300);
+    CHECK(index.visit_table<int>(Visitor{}) == 7);
+    CHECK(MyUnion::create_point(1, 2).visit_table<int>(Visitor{}) == -1);
+
+    // The expected alternative and every other one give the same results as visit
+    CHECK((index.visit_expect<MyUnion::tag_t::index, int>(Visitor{}) == 7));
+    CHECK((index.visit_expect<MyUnion::tag_t::name, int>(Visitor{}) == 7));
+    CHECK((name.visit_expect<MyUnion::tag_t::name, int>(Visitor{}) == 3));
+    CHECK((name.visit_expect<MyUnion::tag_t::point, int>(Visitor{}) == 3));
+    CHECK((std::move(name).visit_expect<MyUnion::tag_t::name, int>(Visitor{}) == 300));
+    CHECK((MyUnion::create_value(1).visit_expect<MyUnion::tag_t::value, int>(Visitor{}) == -1));
+
+    for (MyUnion const &u : {MyUnion::create_index(1), MyUnion::create_value(2), MyUnion::create_name("xy"), MyUnion::create_point(3, 4)}) {
+        CHECK(u.visit_table<int>(Visitor{}) == u.visit<int>(Visitor{}));
+    }
+
+    int calls = 0;
+    name.visit_table<void>([&](auto, auto &&) { ++calls; });
+    CHECK(calls == 1);
+
+    // Visitors may mutate the alternative through a non-const union
+    MyUnion point = MyUnion::create_point(1, 2);
+    point.visit_table<void>(tu::combined_visitor{
+        [](tu::in_place_tag_t<MyUnion::tag_t::point>, auto &p) { p.x = 10; },
+        [](auto, auto &) {},
+    });
+    CHECK(point.get_point_ref().x == 10);
+    return 0;
+}